@@ -437,13 +437,26 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real totalNPV = 0.0;
+        std::vector<Time> times;
+        std::vector<Real> amounts;
+        times.reserve(leg.size());
+        amounts.reserve(leg.size());
         for (const auto& i : leg) {
             if (!i->hasOccurred(settlementDate, includeSettlementDateFlows) &&
-                !i->tradingExCoupon(settlementDate))
-                totalNPV += i->amount() * discountCurve.discount(i->date());
+                !i->tradingExCoupon(settlementDate)) {
+                times.push_back(discountCurve.timeFromReference(i->date()));
+                amounts.push_back(i->amount());
+            }
         }
 
+        // discount factors are retrieved in a single batch call
+        std::vector<DiscountFactor> discounts(times.size());
+        discountCurve.discount(times.data(), discounts.data(), times.size());
+
+        Real totalNPV = 0.0;
+        for (Size i=0; i<times.size(); ++i)
+            totalNPV += amounts[i] * discounts[i];
+
         return totalNPV/discountCurve.discount(npvDate);
     }
 
@@ -0,0 +1,458 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/math/solvers1d/newtonsafe.hpp>
+#include <ql/settings.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        const Spread basisPoint_ = 1.0e-4;
+
+        // same as in cashflows.cpp; the coupon is passed when the
+        // flow is one, so that the cast is only performed once
+        Time stepwiseDiscountTime(const CashFlow& cashFlow,
+                                  const Coupon* coupon,
+                                  const DayCounter& dc,
+                                  Date npvDate,
+                                  Date lastDate) {
+            Date cashFlowDate = cashFlow.date();
+            Date refStartDate, refEndDate;
+            if (coupon != nullptr) {
+                refStartDate = coupon->referencePeriodStart();
+                refEndDate = coupon->referencePeriodEnd();
+            } else {
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDate = cashFlowDate - 1*Years;
+                } else  {
+                    refStartDate = lastDate;
+                }
+                refEndDate = cashFlowDate;
+            }
+
+            if ((coupon != nullptr) && lastDate != coupon->accrualStartDate()) {
+                Time couponPeriod = dc.yearFraction(coupon->accrualStartDate(),
+                                                cashFlowDate, refStartDate, refEndDate);
+                Time accruedPeriod = dc.yearFraction(coupon->accrualStartDate(),
+                                                lastDate, refStartDate, refEndDate);
+                return couponPeriod - accruedPeriod;
+            } else {
+                return dc.yearFraction(lastDate, cashFlowDate,
+                                       refStartDate, refEndDate);
+            }
+        }
+
+        // same check as in the InterestRate constructor
+        void checkFrequency(Compounding comp, Real freq) {
+            if (comp == Compounded || comp == SimpleThenCompounded ||
+                comp == CompoundedThenSimple)
+                QL_REQUIRE(freq != Real(Once) && freq != Real(NoFrequency),
+                           "frequency not allowed for this interest rate");
+        }
+
+        // discount factor as given by InterestRate::discountFactor,
+        // together with the derivative of its logarithm with
+        // respect to the rate
+        DiscountFactor discountFactor(Rate r,
+                                      Compounding comp,
+                                      Real freq,
+                                      Time t,
+                                      Real& dLogDiscount) {
+            QL_REQUIRE(t>=0.0, "negative time (" << t << ") not allowed");
+            bool simple;
+            switch (comp) {
+              case Simple:
+                simple = true;
+                break;
+              case Compounded:
+                simple = false;
+                break;
+              case Continuous:
+                dLogDiscount = -t;
+                return std::exp(-r*t);
+              case SimpleThenCompounded:
+                simple = (t<=1.0/freq);
+                break;
+              case CompoundedThenSimple:
+                simple = (t>1.0/freq);
+                break;
+              default:
+                QL_FAIL("unknown compounding convention (" <<
+                        Integer(comp) << ")");
+            }
+            if (simple) {
+                DiscountFactor B = 1.0/(1.0 + r*t);
+                dLogDiscount = -t*B;
+                return B;
+            } else {
+                Real q = 1.0 + r/freq;
+                dLogDiscount = -t/q;
+                return std::pow(q, -freq*t);
+            }
+        }
+
+        template <class T>
+        Integer sign(T x) {
+            static T zero = T();
+            if (x == zero)
+                return 0;
+            else if (x > zero)
+                return 1;
+            else
+                return -1;
+        }
+
+    }
+
+    class CompiledLeg::YieldFinder {
+      public:
+        YieldFinder(const CompiledLeg& leg,
+                    Real npv,
+                    Compounding comp,
+                    Frequency freq)
+        : leg_(leg), npv_(npv), compounding_(comp), frequency_(freq) {}
+        Real operator()(Rate y) const {
+            return npv_ - leg_.npv(y, compounding_, frequency_, nullptr);
+        }
+        Real derivative(Rate y) const {
+            Real dPdy;
+            leg_.npv(y, compounding_, frequency_, &dPdy);
+            return -dPdy;
+        }
+      private:
+        const CompiledLeg& leg_;
+        Real npv_;
+        Compounding compounding_;
+        Real frequency_;
+    };
+
+    class CompiledLeg::ZSpreadFinder {
+      public:
+        ZSpreadFinder(const CompiledLeg& leg,
+                      Real npv,
+                      const YieldTermStructure& discountCurve,
+                      Compounding comp,
+                      Frequency freq)
+        : leg_(leg), npv_(npv), compounding_(comp), frequency_(freq) {
+            checkFrequency(comp, frequency_);
+            // the NPV-date time is stored last
+            leg_.curveTimes(discountCurve, times_);
+            zeroRates_.resize(times_.size());
+            // the range is checked as the spreaded curve would do
+            discountCurve.zeroRate(times_.data(), zeroRates_.data(),
+                                   times_.size(), comp, freq, false);
+        }
+        Real operator()(Spread s) const {
+            return npv_ - value(s, nullptr);
+        }
+        Real derivative(Spread s) const {
+            Real dPds;
+            value(s, &dPds);
+            return -dPds;
+        }
+        Real value(Spread s, Real* derivative) const {
+            Size n = leg_.size();
+            const Real* amounts = leg_.amounts_.data();
+            Real P = 0.0, dP = 0.0, dLogB;
+            for (Size i=0; i<n; ++i) {
+                // ZeroYieldStructure returns 1 at t=0 regardless of the rate
+                if (times_[i] == 0.0) {
+                    P += amounts[i];
+                    continue;
+                }
+                DiscountFactor B = discountFactor(zeroRates_[i]+s,
+                                                  compounding_, frequency_,
+                                                  times_[i], dLogB);
+                P += amounts[i] * B;
+                dP += amounts[i] * B * dLogB;
+            }
+            DiscountFactor B0 = 1.0;
+            Real dLogB0 = 0.0;
+            if (times_[n] != 0.0)
+                B0 = discountFactor(zeroRates_[n]+s, compounding_,
+                                    frequency_, times_[n], dLogB0);
+            if (derivative != nullptr)
+                *derivative = (dP - P*dLogB0)/B0;
+            return P/B0;
+        }
+      private:
+        const CompiledLeg& leg_;
+        Real npv_;
+        Compounding compounding_;
+        Real frequency_;
+        std::vector<Time> times_;
+        std::vector<Rate> zeroRates_;
+    };
+
+
+    CompiledLeg::CompiledLeg(const Leg& leg,
+                             DayCounter dayCounter,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate)
+    : dayCounter_(std::move(dayCounter)), settlementDate_(settlementDate),
+      npvDate_(npvDate) {
+
+        if (settlementDate_ == Date())
+            settlementDate_ = Settings::instance().evaluationDate();
+
+        if (npvDate_ == Date())
+            npvDate_ = settlementDate_;
+
+#if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(std::adjacent_find(leg.begin(), leg.end(),
+                                      [](const ext::shared_ptr<CashFlow>& c,
+                                         const ext::shared_ptr<CashFlow>& d) {
+                                          return c->date() > d->date();
+                                      }) == leg.end(),
+                   "cashflows must be sorted in ascending order w.r.t. their payment dates");
+#endif
+
+        dates_.reserve(leg.size());
+        amounts_.reserve(leg.size());
+        steps_.reserve(leg.size());
+        times_.reserve(leg.size());
+        accruals_.reserve(leg.size());
+        bpsTimes_.reserve(leg.size());
+
+        Time t = 0.0;
+        Date lastDate = npvDate_;
+        for (const auto& i : leg) {
+            if (i->hasOccurred(settlementDate_, includeSettlementDateFlows))
+                continue;
+
+            const auto* coupon = dynamic_cast<const Coupon*>(i.get());
+            bool exCoupon = i->tradingExCoupon(settlementDate_);
+            Date d = i->date();
+
+            Time step = stepwiseDiscountTime(*i, coupon, dayCounter_,
+                                             npvDate_, lastDate);
+            t += step;
+            minStep_ = std::min(minStep_, step);
+
+            dates_.push_back(d);
+            amounts_.push_back(exCoupon ? 0.0 : i->amount());
+            steps_.push_back(step);
+            times_.push_back(t);
+            accruals_.push_back((coupon != nullptr && !exCoupon) ?
+                                coupon->nominal() * coupon->accrualPeriod() :
+                                0.0);
+            bpsTimes_.push_back(dayCounter_.yearFraction(settlementDate_, d));
+
+            lastDate = d;
+        }
+        npvBpsTime_ = dayCounter_.yearFraction(settlementDate_, npvDate_);
+    }
+
+    void CompiledLeg::curveTimes(const YieldTermStructure& discountCurve,
+                                 std::vector<Time>& times) const {
+        times.resize(dates_.size()+1);
+        for (Size i=0; i<dates_.size(); ++i)
+            times[i] = discountCurve.timeFromReference(dates_[i]);
+        times.back() = discountCurve.timeFromReference(npvDate_);
+    }
+
+    void CompiledLeg::checkYieldDayCounter(const InterestRate& yield) const {
+        QL_REQUIRE(yield.dayCounter() == dayCounter_,
+                   "yield day counter (" << yield.dayCounter().name()
+                   << ") different from the one of the compiled leg ("
+                   << dayCounter_.name() << ")");
+    }
+
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve) const {
+        if (empty())
+            return 0.0;
+
+        std::vector<Time> times;
+        curveTimes(discountCurve, times);
+        std::vector<DiscountFactor> discounts(times.size());
+        discountCurve.discount(times.data(), discounts.data(), times.size());
+
+        Real totalNPV = 0.0;
+        for (Size i=0; i<dates_.size(); ++i)
+            totalNPV += amounts_[i] * discounts[i];
+        return totalNPV/discounts.back();
+    }
+
+    Real CompiledLeg::bps(const YieldTermStructure& discountCurve) const {
+        if (empty())
+            return 0.0;
+
+        std::vector<Time> times;
+        curveTimes(discountCurve, times);
+        std::vector<DiscountFactor> discounts(times.size());
+        discountCurve.discount(times.data(), discounts.data(), times.size());
+
+        Real bps = 0.0;
+        for (Size i=0; i<dates_.size(); ++i)
+            bps += accruals_[i] * discounts[i];
+        return basisPoint_*bps/discounts.back();
+    }
+
+
+    Real CompiledLeg::npv(Rate yield,
+                          Compounding compounding,
+                          Real frequency,
+                          Real* derivative) const {
+        QL_REQUIRE(yield != Null<Rate>(), "null interest rate");
+        checkFrequency(compounding, frequency);
+        QL_REQUIRE(minStep_ >= 0.0,
+                   "negative time (" << minStep_ << ") not allowed");
+
+        Size n = dates_.size();
+        const Real* a = amounts_.data();
+        Real P = 0.0, dPdy = 0.0;
+
+        if (compounding == Continuous || compounding == Compounded) {
+            // the product of the stepwise discount factors only
+            // depends on the cumulative time, which allows a single
+            // exponential per flow in a loop without branches
+            Real k, dk;
+            if (compounding == Continuous) {
+                k = yield;
+                dk = 1.0;
+            } else {
+                k = frequency*std::log(1.0 + yield/frequency);
+                dk = 1.0/(1.0 + yield/frequency);
+            }
+            const Time* t = times_.data();
+            for (Size i=0; i<n; ++i) {
+                Real B = std::exp(-k*t[i]);
+                P += a[i]*B;
+                dPdy -= a[i]*B*t[i];
+            }
+            dPdy *= dk;
+        } else {
+            DiscountFactor discount = 1.0;
+            Real dLogDiscount = 0.0, dLogB;
+            for (Size i=0; i<n; ++i) {
+                discount *= discountFactor(yield, compounding, frequency,
+                                           steps_[i], dLogB);
+                dLogDiscount += dLogB;
+                P += a[i]*discount;
+                dPdy += a[i]*discount*dLogDiscount;
+            }
+        }
+
+        if (derivative != nullptr)
+            *derivative = dPdy;
+        return P;
+    }
+
+    Real CompiledLeg::npv(const InterestRate& yield) const {
+        checkYieldDayCounter(yield);
+        return npv(yield.rate(), yield.compounding(), yield.frequency());
+    }
+
+    Real CompiledLeg::npv(Rate yield,
+                          Compounding compounding,
+                          Frequency frequency) const {
+        if (empty())
+            return 0.0;
+        return npv(yield, compounding, Real(frequency), nullptr);
+    }
+
+    Real CompiledLeg::bps(const InterestRate& yield) const {
+        checkYieldDayCounter(yield);
+        return bps(yield.rate(), yield.compounding(), yield.frequency());
+    }
+
+    Real CompiledLeg::bps(Rate yield,
+                          Compounding compounding,
+                          Frequency frequency) const {
+        checkFrequency(compounding, Real(frequency));
+        // same as discounting on a flat curve starting at settlement
+        Real dLogB, bps = 0.0;
+        for (Size i=0; i<dates_.size(); ++i) {
+            if (accruals_[i] != 0.0)
+                bps += accruals_[i] *
+                    discountFactor(yield, compounding, Real(frequency),
+                                   bpsTimes_[i], dLogB);
+        }
+        return basisPoint_*bps/
+            discountFactor(yield, compounding, Real(frequency),
+                           npvBpsTime_, dLogB);
+    }
+
+    Rate CompiledLeg::yield(Real npv,
+                            Compounding compounding,
+                            Frequency frequency,
+                            Real accuracy,
+                            Size maxIterations,
+                            Rate guess) const {
+        // depending on the sign of the market price, check that cash
+        // flows of the opposite sign have been specified (otherwise
+        // IRR is nonsensical.)  Flows trading ex-coupon have a null
+        // amount and are therefore skipped.
+        Integer lastSign = sign(Real(-npv)),
+                signChanges = 0;
+        for (Real amount : amounts_) {
+            Integer thisSign = sign(amount);
+            if (lastSign * thisSign < 0) // sign change
+                signChanges++;
+
+            if (thisSign != 0)
+                lastSign = thisSign;
+        }
+        QL_REQUIRE(signChanges > 0,
+                   "the given cash flows cannot result in the given market "
+                   "price due to their sign");
+
+        NewtonSafe solver;
+        solver.setMaxEvaluations(maxIterations);
+        YieldFinder objFunction(*this, npv, compounding, frequency);
+        return solver.solve(objFunction, accuracy, guess, guess/10.0);
+    }
+
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve,
+                          Spread zSpread,
+                          Compounding compounding,
+                          Frequency frequency) const {
+        if (empty())
+            return 0.0;
+
+        ZSpreadFinder f(*this, 0.0, discountCurve, compounding, frequency);
+        return f.value(zSpread, nullptr);
+    }
+
+    Spread CompiledLeg::zSpread(Real npv,
+                                const YieldTermStructure& discountCurve,
+                                Compounding compounding,
+                                Frequency frequency,
+                                Real accuracy,
+                                Size maxIterations,
+                                Rate guess) const {
+        NewtonSafe solver;
+        solver.setMaxEvaluations(maxIterations);
+        ZSpreadFinder objFunction(*this, npv, discountCurve,
+                                  compounding, frequency);
+        Real step = 0.01;
+        return solver.solve(objFunction, accuracy, guess, step);
+    }
+
+}
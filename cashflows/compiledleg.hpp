@@ -0,0 +1,153 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief Flat snapshot of a leg for repeated cash-flow analysis
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/interestrate.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class YieldTermStructure;
+
+    //! flat snapshot of a leg for repeated cash-flow analysis
+    /*! The leg is scanned once at construction: the flows alive at
+        the settlement date are stored as plain arrays of payment
+        dates, amounts, discounting times and coupon accruals.  The
+        methods below reproduce the corresponding CashFlows functions
+        on such arrays, without going through the cash-flow objects;
+        the yield and z-spread solvers use analytic derivatives and
+        re-evaluate the stored arrays at each iteration.
+
+        This is useful when the same leg is analyzed many times,
+        e.g., when pricing a bond at many yields or when solving
+        for yields and spreads across a large portfolio.
+
+        \warning the amounts are read at construction.  Changes in
+                 the leg (e.g., in the index fixings or forecast
+                 curves of floating-rate coupons) are not reflected
+                 in an existing instance, which must be rebuilt.
+
+        \ingroup cashflows
+    */
+    class CompiledLeg {
+      public:
+        /*! The day counter is the one used for yield-based
+            calculations; curve-based calculations use the day
+            counter of the passed curve.  Null settlement and NPV
+            dates are replaced as in the CashFlows functions.
+        */
+        CompiledLeg(const Leg& leg,
+                    DayCounter dayCounter,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate = Date(),
+                    Date npvDate = Date());
+        //! \name Inspectors
+        //@{
+        //! number of flows alive at the settlement date
+        Size size() const { return dates_.size(); }
+        bool empty() const { return dates_.empty(); }
+        const DayCounter& dayCounter() const { return dayCounter_; }
+        Date settlementDate() const { return settlementDate_; }
+        Date npvDate() const { return npvDate_; }
+        const std::vector<Date>& dates() const { return dates_; }
+        /*! amounts of the alive flows; the amounts of flows trading
+            ex-coupon are set to zero. */
+        const std::vector<Real>& amounts() const { return amounts_; }
+        //@}
+        //! \name YieldTermStructure functions
+        //@{
+        //! same as CashFlows::npv(leg, discountCurve, ...)
+        Real npv(const YieldTermStructure& discountCurve) const;
+        //! same as CashFlows::bps(leg, discountCurve, ...)
+        Real bps(const YieldTermStructure& discountCurve) const;
+        //@}
+        //! \name Yield (a.k.a. Internal Rate of Return, i.e. IRR) functions
+        //@{
+        /*! same as CashFlows::npv(leg, yield, ...); the day counter
+            of the yield must match the one passed at construction.
+        */
+        Real npv(const InterestRate& yield) const;
+        Real npv(Rate yield,
+                 Compounding compounding,
+                 Frequency frequency) const;
+        //! same as CashFlows::bps(leg, yield, ...)
+        Real bps(const InterestRate& yield) const;
+        Real bps(Rate yield,
+                 Compounding compounding,
+                 Frequency frequency) const;
+        //! same as CashFlows::yield(leg, npv, ...)
+        Rate yield(Real npv,
+                   Compounding compounding,
+                   Frequency frequency,
+                   Real accuracy = 1.0e-10,
+                   Size maxIterations = 100,
+                   Rate guess = 0.05) const;
+        //@}
+        //! \name Z-spread functions
+        //@{
+        /*! same as CashFlows::npv(leg, discountCurve, zSpread, ...).
+            The spreaded discount factors are obtained as in
+            ZeroSpreadedTermStructure, whose day counter is not used
+            and is therefore not required here.
+        */
+        Real npv(const YieldTermStructure& discountCurve,
+                 Spread zSpread,
+                 Compounding compounding,
+                 Frequency frequency) const;
+        //! same as CashFlows::zSpread(leg, npv, discountCurve, ...)
+        Spread zSpread(Real npv,
+                       const YieldTermStructure& discountCurve,
+                       Compounding compounding,
+                       Frequency frequency,
+                       Real accuracy = 1.0e-10,
+                       Size maxIterations = 100,
+                       Rate guess = 0.0) const;
+        //@}
+      private:
+        class YieldFinder;
+        class ZSpreadFinder;
+        Real npv(Rate yield,
+                 Compounding compounding,
+                 Real frequency,
+                 Real* derivative) const;
+        void curveTimes(const YieldTermStructure& discountCurve,
+                        std::vector<Time>& times) const;
+        void checkYieldDayCounter(const InterestRate& yield) const;
+        DayCounter dayCounter_;
+        Date settlementDate_, npvDate_;
+        std::vector<Date> dates_;
+        std::vector<Real> amounts_;
+        // stepwise and cumulative discounting times for yields
+        std::vector<Time> steps_, times_;
+        Time minStep_ = 0.0;
+        // nominal times accrual period for coupons, zero otherwise
+        std::vector<Real> accruals_;
+        // times from the settlement date, used for flat-rate BPS
+        std::vector<Time> bpsTimes_;
+        Time npvBpsTime_ = 0.0;
+    };
+
+}
+
+#endif
@@ -28,6 +28,10 @@
 #include <ql/utilities/vectors.hpp>
 #include <utility>
 #include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
 
 using std::vector;
 
@@ -35,6 +39,161 @@ namespace QuantLib {
 
     namespace {
 
+        /* Cumulative compounding factors over the stored fixings of
+           an overnight index.  logFactors_[k] is the sum of the logs
+           of the daily factors 1 + f_j tau_j for j < k, tau_j being
+           the accrual period between the value dates of consecutive
+           fixings; the sum is compensated so that differences keep
+           the accuracy of the direct product.  The realized part of
+           any coupon whose fixings are consecutive in the history
+           can then be obtained from two sums.  The history itself is
+           not stored; only its revision is, and the history passed
+           to compoundFactor must be the one the factors were built
+           from.  When fixings are appended to the history, the sums
+           are extended rather than calculated again.
+        */
+        class CompoundingFactors {
+          public:
+            CompoundingFactors(const OvernightIndex& index,
+                               const FixingHistory& history)
+            : dayCounter_(index.dayCounter()),
+              calendar_(index.fixingCalendar()),
+              fixingDays_(index.fixingDays()) {
+                extend(history);
+            }
+            //! extends the given factors with the appended fixings
+            CompoundingFactors(const CompoundingFactors& factors,
+                               const FixingHistory& history)
+            : CompoundingFactors(factors) {
+                extend(history);
+            }
+            bool isValidFor(const OvernightIndex& index) const {
+                return index.fixingDays() == fixingDays_
+                    && index.dayCounter() == dayCounter_
+                    && index.fixingCalendar() == calendar_;
+            }
+            bool isValidFor(const FixingHistory& history) const {
+                return history.revision() == revision_;
+            }
+            bool isExtensibleTo(const FixingHistory& history) const {
+                return history.lineage() == lineage_
+                    && history.size() >= valueDates_.size();
+            }
+            /*! returns the product of the daily factors of the fixings
+                from first (included) to last (excluded), or null if
+                such fixings are not consecutive in the history.
+            */
+            Real compoundFactor(const FixingHistory& history,
+                                const vector<Date>& fixingDates,
+                                const vector<Date>& valueDates,
+                                Size first,
+                                Size last) const {
+                if (history.revision() != revision_)
+                    return Null<Real>();
+                Size p = history.locate(fixingDates[first]);
+                Size q = p + (last - first);
+                if (q >= history.size() ||
+                    missingFixings_[q] != missingFixings_[p])
+                    return Null<Real>();
+                // the history might store fixings at other dates
+                // than those of the coupon, which would replace its
+                // missing ones; the dates are checked one by one,
+                // which is still much cheaper than compounding
+                const FixingHistory::serial_type* serials = history.serials();
+                for (Size k=0; k<=last-first; ++k) {
+                    if (serials[p+k] != fixingDates[first+k].serialNumber() ||
+                        valueDates_[p+k] != valueDates[first+k])
+                        return Null<Real>();
+                }
+                return std::exp(logFactors_[q] - logFactors_[p]);
+            }
+          private:
+            void extend(const FixingHistory& history) {
+                Size m = valueDates_.size(), n = history.size();
+                const Real* values = history.values();
+                const FixingHistory::serial_type* serials = history.serials();
+                valueDates_.resize(n);
+                for (Size j=m; j<n; ++j)
+                    valueDates_[j] = calendar_.advance(
+                        Date(Date::serial_type(serials[j])), fixingDays_, Days);
+
+                // the factor of the last fixing was pending, since it
+                // needs the value date of the next one
+                logFactors_.resize(n);
+                missingFixings_.resize(n);
+                for (Size j=(m > 0 ? m-1 : 0); j+1<n; ++j) {
+                    logFactors_[j] = sum_;
+                    missingFixings_[j] = missing_;
+                    Real factor = 1.0;
+                    if (values[j] != Null<Real>())
+                        factor += values[j] * dayCounter_.yearFraction(
+                                                valueDates_[j], valueDates_[j+1]);
+                    if (values[j] == Null<Real>() || factor <= 0.0) {
+                        ++missing_;
+                        continue;
+                    }
+                    Real y = std::log(factor) - compensation_;
+                    Real t = sum_ + y;
+                    compensation_ = (t - sum_) - y;
+                    sum_ = t;
+                }
+                if (n > 0) {
+                    logFactors_[n-1] = sum_;
+                    missingFixings_[n-1] = missing_;
+                }
+                revision_ = history.revision();
+                lineage_ = history.lineage();
+            }
+            std::uint64_t revision_ = 0, lineage_ = 0;
+            DayCounter dayCounter_;
+            Calendar calendar_;
+            Natural fixingDays_;
+            vector<Date> valueDates_;
+            vector<Real> logFactors_;
+            vector<Size> missingFixings_;
+            // running sums over the fixings but the last
+            Real sum_ = 0.0, compensation_ = 0.0;
+            Size missing_ = 0;
+        };
+
+        // the factors are extended when fixings are appended to the
+        // history of the index, and rebuilt when it changes otherwise;
+        // lookups of valid factors only take a shared lock, so that
+        // concurrent pricings don't serialize on the cache
+        ext::shared_ptr<const CompoundingFactors>
+        compoundingFactors(const OvernightIndex& index,
+                           const FixingHistory& history) {
+            typedef std::map<std::string,
+                             ext::shared_ptr<const CompoundingFactors> > cache_type;
+            static std::shared_timed_mutex mutex;
+            static cache_type cache;
+            const std::string name = index.name();
+            ext::shared_ptr<const CompoundingFactors> factors;
+            {
+                std::shared_lock<std::shared_timed_mutex> lock(mutex);
+                cache_type::const_iterator i = cache.find(name);
+                if (i != cache.end() && i->second->isValidFor(index)) {
+                    if (i->second->isValidFor(history))
+                        return i->second;
+                    factors = i->second;
+                }
+            }
+            // built outside the lock; if another thread did the
+            // same meanwhile, either result can be stored.  The
+            // factors might be in use, hence they are extended in
+            // a copy.
+            if (factors != nullptr && factors->isExtensibleTo(history))
+                factors = ext::make_shared<const CompoundingFactors>(*factors, history);
+            else
+                factors = ext::make_shared<const CompoundingFactors>(index, history);
+            std::lock_guard<std::shared_timed_mutex> lock(mutex);
+            cache[name] = factors;
+            return factors;
+        }
+
+        // below this number of fixings, walking them is cheaper
+        const Size minimumCachedFixings = 8;
+
         class OvernightIndexedCouponPricer : public FloatingRateCouponPricer {
           public:
             void initialize(const FloatingRateCoupon& coupon) override {
@@ -48,7 +207,7 @@ namespace QuantLib {
 
                 const ext::shared_ptr<OvernightIndex> index =
                     ext::dynamic_pointer_cast<OvernightIndex>(coupon_->index());
-                const auto& pastFixings = IndexManager::instance().getHistory(index->name());
+                const auto& pastFixings = IndexManager::instance().fixings(index->name());
 
                 const vector<Date>& fixingDates = coupon_->fixingDates();
                 const vector<Date>& valueDates = coupon_->valueDates();
@@ -58,7 +217,21 @@ namespace QuantLib {
                 const size_t n = std::lower_bound(valueDates.begin(), valueDates.end(), date) - valueDates.begin();
                 Real compoundFactor = 1.0;
 
-                // already fixed part
+                // already fixed part; all the fixings but the last one
+                // (whose span might be partial) are taken from the
+                // cumulative factors when possible, the others below
+                const Size fixed = std::min<Size>(
+                    n, std::lower_bound(fixingDates.begin(), fixingDates.end(), today)
+                           - fixingDates.begin());
+                if (fixed > minimumCachedFixings) {
+                    const Real f = compoundingFactors(*index, pastFixings)
+                        ->compoundFactor(pastFixings, fixingDates, valueDates,
+                                         0, fixed-1);
+                    if (f != Null<Real>()) {
+                        compoundFactor = f;
+                        i = fixed-1;
+                    }
+                }
                 while (i < n && fixingDates[i] < today) {
                     // rate must have been fixed
                     const Rate fixing = pastFixings[fixingDates[i]];
@@ -50,7 +50,7 @@ namespace QuantLib {
         Date today = Settings::instance().evaluationDate();
         while (i < n && fixingDates[i] < today) {
             // rate must have been fixed
-            Rate pastFixing = IndexManager::instance().getHistory(
+            Rate pastFixing = IndexManager::instance().fixings(
                 index->name())[fixingDates[i]];
             QL_REQUIRE(pastFixing != Null<Real>(),
                 "Missing " << index->name() <<
@@ -63,7 +63,7 @@ namespace QuantLib {
         if (i < n && fixingDates[i] == today) {
             // might have been fixed
             try {
-                Rate pastFixing = IndexManager::instance().getHistory(
+                Rate pastFixing = IndexManager::instance().fixings(
                     index->name())[fixingDates[i]];
                 if (pastFixing != Null<Real>()) {
                     accumulatedRate += pastFixing*dt[i];
@@ -90,4 +90,14 @@ namespace QuantLib {
         }
     }
 
+    void ExtendedBlackScholesMertonProcess::evolveBatch(Time t0,
+                                                        const Real* x0,
+                                                        Time dt,
+                                                        const Real* dw,
+                                                        Real* x,
+                                                        Size n) const {
+        // the exact evolution of the base class doesn't apply here
+        StochasticProcess1D::evolveBatch(t0, x0, dt, dw, x, n);
+    }
+
 }
@@ -18,8 +18,11 @@
 */
 
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/patterns/lazyobjectgraph.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/instrument.hpp>
+#include <algorithm>
+#include <string>
 
 using std::vector;
 using std::pair;
@@ -344,4 +347,105 @@ namespace QuantLib {
         return result;
     }
 
+
+    void multiThreadedBucketAnalysis(
+              Matrix& deltaMatrix, // result
+              Matrix& gammaMatrix, // result
+              const std::function<SensitivityAnalysisContext()>& factory,
+              Size workers,
+              Real shift,
+              SensitivityAnalysis type) {
+        QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+        QL_REQUIRE(workers > 0, "at least one worker required");
+        QL_REQUIRE(type == OneSide || type == Centered,
+                   "unknown SensitivityAnalysis (" << Integer(type) << ")");
+
+        // QuantLib objects are not thread-safe; each worker gets its
+        // own copy of the market, built here sequentially
+        vector<SensitivityAnalysisContext> contexts(workers);
+        for (Size w=0; w<workers; ++w)
+            contexts[w] = factory();
+
+        const Size n = contexts[0].quotes.size();
+        const Size m = contexts[0].instruments.size();
+        QL_REQUIRE(n > 0, "empty SimpleQuote vector");
+        for (Size w=1; w<workers; ++w) {
+            QL_REQUIRE(contexts[w].quotes.size() == n &&
+                       contexts[w].instruments.size() == m,
+                       "inconsistent contexts returned by factory");
+        }
+
+        deltaMatrix = Matrix(n, m, 0.0);
+        gammaMatrix = Matrix(n, m, type == Centered ? 0.0 : Null<Real>());
+        if (m == 0)
+            return;
+
+        // the contexts are equivalent, so the instruments affected
+        // by each quote and the reference NPVs are found on the first
+        const SensitivityAnalysisContext& first = contexts[0];
+        vector<ext::shared_ptr<LazyObject> > nodes(first.instruments.begin(),
+                                                   first.instruments.end());
+        LazyObjectGraph graph(nodes);
+        vector<vector<Size> > affected(n);
+        for (Size i=0; i<n; ++i) {
+            // as in bucketAnalysis, invalid quotes give null sensitivities
+            if (!first.quotes[i]->isValid()) {
+                std::fill(deltaMatrix.row_begin(i), deltaMatrix.row_end(i),
+                          Null<Real>());
+                std::fill(gammaMatrix.row_begin(i), gammaMatrix.row_end(i),
+                          Null<Real>());
+                continue;
+            }
+            vector<ext::shared_ptr<Observable> > changed(
+                                       1, first.quotes[i].currentLink());
+            vector<bool> dependsOn = graph.dependsOn(nodes, changed);
+            for (Size k=0; k<m; ++k)
+                if (dependsOn[k])
+                    affected[i].push_back(k);
+        }
+        vector<Real> referenceNpv(m);
+        for (Size k=0; k<m; ++k)
+            referenceNpv[k] = first.instruments[k]->NPV();
+
+        vector<std::string> errors(workers);
+        #pragma omp parallel for num_threads(workers) schedule(static, 1)
+        for (long w=0; w<(long)workers; w++) {
+            const SensitivityAnalysisContext& context = contexts[w];
+            vector<Real> npv(m);
+            // quotes are assigned round-robin to balance the load
+            for (Size i=w; i<n; i+=workers) {
+                if (affected[i].empty())
+                    continue;
+                const Handle<SimpleQuote>& quote = context.quotes[i];
+                Real quoteValue = quote->value();
+                try {
+                    quote->setValue(quoteValue+shift);
+                    for (Size k : affected[i])
+                        npv[k] = context.instruments[k]->NPV();
+                    if (type == OneSide) {
+                        for (Size k : affected[i])
+                            deltaMatrix[i][k] =
+                                (npv[k]-referenceNpv[k])/shift;
+                    } else {
+                        quote->setValue(quoteValue-shift);
+                        for (Size k : affected[i]) {
+                            Real npv2 = context.instruments[k]->NPV();
+                            deltaMatrix[i][k] = (npv[k]-npv2)/(2.0*shift);
+                            gammaMatrix[i][k] =
+                                (npv[k]-2.0*referenceNpv[k]+npv2)
+                                /(shift*shift);
+                        }
+                    }
+                    quote->setValue(quoteValue);
+                } catch (std::exception& e) {
+                    quote->setValue(quoteValue);
+                    errors[w] = e.what();
+                    break;
+                }
+            }
+        }
+        for (Size w=0; w<workers; ++w)
+            QL_REQUIRE(errors[w].empty(), errors[w]);
+    }
+
 }
@@ -24,15 +24,16 @@
 #ifndef quantlib_sensitivity_analysis_hpp
 #define quantlib_sensitivity_analysis_hpp
 
+#include <ql/handle.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/types.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/shared_ptr.hpp>
+#include <functional>
 #include <vector>
 
 namespace QuantLib {
 
-    template <class T>
-    class Handle;
     class Quote;
     class SimpleQuote;
     class Instrument;
@@ -173,6 +174,46 @@ namespace QuantLib {
                    Real shift = 0.0001,
                    SensitivityAnalysis type = Centered);
 
+    //! market and portfolio used by multiThreadedBucketAnalysis
+    struct SensitivityAnalysisContext {
+        std::vector<Handle<SimpleQuote> > quotes;
+        std::vector<ext::shared_ptr<Instrument> > instruments;
+    };
+
+    //! bucket sensitivity analysis distributed across threads
+    /*! The quotes are tweaked one by one separately, as in
+        bucketAnalysis; the bumps are distributed among the given
+        number of workers, which run in parallel when OpenMP is
+        enabled.
+
+        Since QuantLib objects can't be shared among threads, each
+        worker uses its own copy of the market and the portfolio,
+        built by the given factory.  The factory is called once per
+        worker, sequentially, and must return equivalent contexts
+        each time.  The instruments depending on each quote are found
+        from the observer registrations (see LazyObjectGraph) and
+        only those are revalued when the quote is tweaked.
+
+        On return, deltaMatrix[i][k] and gammaMatrix[i][k] contain
+        the first and second derivative of the NPV of the k-th
+        instrument with respect to the i-th quote; they are zero for
+        instruments not depending on the quote, and null for all
+        instruments if the quote is not valid.  Second derivatives
+        are not available if SensitivityAnalysis is OneSide.
+
+        \warning the contexts must not share observables or lazy
+                 objects, and no global notification (e.g., a change
+                 of evaluation date) can be sent during the
+                 calculation.
+    */
+    void multiThreadedBucketAnalysis(
+              Matrix& deltaMatrix, // result
+              Matrix& gammaMatrix, // result
+              const std::function<SensitivityAnalysisContext()>& factory,
+              Size workers,
+              Real shift = 0.0001,
+              SensitivityAnalysis type = Centered);
+
 }
 
 #endif
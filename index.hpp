@@ -30,6 +30,8 @@
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/time/calendar.hpp>
+#include <algorithm>
+#include <map>
 
 namespace QuantLib {
 
@@ -91,20 +93,47 @@ namespace QuantLib {
                         bool forceOverwrite = false) {
             checkNativeFixingsAllowed();
             std::string tag = name();
-            TimeSeries<Real> h = IndexManager::instance().getHistory(tag);
+            const FixingHistory& h = IndexManager::instance().fixings(tag);
+            // only the new fixings are collected; the stored history
+            // is updated in place afterwards
+            std::vector<Date> dates;
+            std::vector<Real> values;
+            // positions of the collected fixings; only built if the
+            // given dates are not increasing
+            std::map<Date, Size> positions;
             bool noInvalidFixing = true, noDuplicatedFixing = true;
-            Date invalidDate, duplicatedDate;
+            Date invalidDate, duplicatedDate, lastAddedDate;
             Real nullValue = Null<Real>();
             Real invalidValue = Null<Real>();
             Real duplicatedValue = Null<Real>();
             while (dBegin != dEnd) {
                 bool validFixing = isValidFixingDate(*dBegin);
-                Real currentValue = h[*dBegin];
+                // fixings added earlier in this call take precedence
+                Size added = dates.size();
+                if (!dates.empty() && *dBegin <= lastAddedDate) {
+                    if (positions.empty()) {
+                        for (Size i=0; i<dates.size(); ++i)
+                            positions.emplace_hint(positions.end(), dates[i], i);
+                    }
+                    auto p = positions.find(*dBegin);
+                    if (p != positions.end())
+                        added = p->second;
+                }
+                Real currentValue = added != dates.size() ? values[added] : h[*dBegin];
                 bool missingFixing = forceOverwrite || currentValue == nullValue;
                 if (validFixing) {
-                    if (missingFixing)
-                        h[*(dBegin++)] = *(vBegin++);
-                    else if (close(currentValue, *(vBegin))) {
+                    if (missingFixing) {
+                        if (added != dates.size()) {
+                            values[added] = *(vBegin++);
+                            ++dBegin;
+                        } else {
+                            lastAddedDate = std::max(lastAddedDate, *dBegin);
+                            if (!positions.empty())
+                                positions.emplace(*dBegin, dates.size());
+                            dates.push_back(*(dBegin++));
+                            values.push_back(*(vBegin++));
+                        }
+                    } else if (close(currentValue, *(vBegin))) {
                         ++dBegin;
                         ++vBegin;
                     } else {
@@ -118,7 +147,7 @@ namespace QuantLib {
                     invalidValue = *(vBegin++);
                 }
             }
-            IndexManager::instance().setHistory(tag, h);
+            IndexManager::instance().addFixings(tag, dates, values);
             QL_REQUIRE(noInvalidFixing, "At least one invalid fixing provided: "
                                             << invalidDate.weekday() << " " << invalidDate << ", "
                                             << invalidValue);
@@ -127,6 +156,7 @@ namespace QuantLib {
                                                << " while " << h[duplicatedDate]
                                                << " value is already present");
         }
+
         //! clears all stored historical fixings
         void clearFixings();
 
@@ -0,0 +1,222 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/indexes/fixinghistory.hpp>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        std::atomic<std::uint64_t> lastRevision(0);
+
+    }
+
+    FixingHistory::FixingHistory(const TimeSeries<Real>& history) {
+        touch();
+        serials_.reserve(history.size());
+        values_.reserve(history.size());
+        for (const auto& i : history) {
+            serials_.push_back(serial_type(i.first.serialNumber()));
+            values_.push_back(i.second);
+        }
+    }
+
+    FixingHistory::FixingHistory(const serial_type* serials,
+                                 const Real* values,
+                                 Size size,
+                                 ext::shared_ptr<void> storage)
+    : viewSerials_(serials), viewValues_(values), viewSize_(size),
+      storage_(std::move(storage)) {
+        QL_REQUIRE(storage_ != nullptr, "null fixing storage");
+        touch();
+    }
+
+    FixingHistory::Lineage::Lineage() : id(++lastRevision) {}
+
+    FixingHistory::Lineage::Lineage(const Lineage&) : id(++lastRevision) {}
+
+    FixingHistory::Lineage&
+    FixingHistory::Lineage::operator=(const Lineage&) {
+        id = ++lastRevision;
+        return *this;
+    }
+
+    void FixingHistory::touch() {
+        revision_ = ++lastRevision;
+    }
+
+    Date FixingHistory::firstDate() const {
+        QL_REQUIRE(!empty(), "empty fixing history");
+        return Date(Date::serial_type(serials()[0]));
+    }
+
+    Date FixingHistory::lastDate() const {
+        QL_REQUIRE(!empty(), "empty fixing history");
+        return Date(Date::serial_type(serials()[size()-1]));
+    }
+
+    std::vector<Date> FixingHistory::dates() const {
+        const serial_type* s = serials();
+        std::vector<Date> result;
+        result.reserve(size());
+        for (Size i=0; i<size(); ++i)
+            result.emplace_back(Date::serial_type(s[i]));
+        return result;
+    }
+
+    TimeSeries<Real> FixingHistory::timeSeries() const {
+        std::vector<Date> d = dates();
+        return TimeSeries<Real>(d.begin(), d.end(), values());
+    }
+
+    Size FixingHistory::find(serial_type serial) const {
+        const serial_type* s = serials();
+        Size n = size();
+        if (n == 0 || serial < s[0] || serial > s[n-1])
+            return n;
+
+        // interpolation guess; exact for regularly spaced fixings
+        Size i = 0;
+        if (s[n-1] > s[0])
+            i = Size((std::int64_t(serial) - s[0]) * std::int64_t(n-1)
+                     / (std::int64_t(s[n-1]) - s[0]));
+        if (s[i] == serial)
+            return i;
+
+        // exponential search from the guess, then bisection
+        Size lo, hi, step = 1;
+        if (s[i] < serial) {
+            lo = i;
+            hi = i + 1;
+            while (s[hi] < serial) {
+                lo = hi;
+                hi = std::min(hi + step, n - 1);
+                step *= 2;
+            }
+        } else {
+            hi = i;
+            lo = i - 1;
+            while (s[lo] > serial) {
+                hi = lo;
+                lo = lo > step ? lo - step : 0;
+                step *= 2;
+            }
+        }
+        const serial_type* j = std::lower_bound(s + lo, s + hi + 1, serial);
+        return *j == serial ? Size(j - s) : n;
+    }
+
+    void FixingHistory::detach() {
+        if (storage_ == nullptr)
+            return;
+        serials_.assign(viewSerials_, viewSerials_ + viewSize_);
+        values_.assign(viewValues_, viewValues_ + viewSize_);
+        viewSerials_ = nullptr;
+        viewValues_ = nullptr;
+        viewSize_ = 0;
+        storage_.reset();
+    }
+
+    void FixingHistory::add(const std::vector<Date>& dates,
+                            const std::vector<Real>& values) {
+        QL_REQUIRE(dates.size() == values.size(),
+                   "size mismatch between dates (" << dates.size()
+                   << ") and values (" << values.size() << ")");
+        if (dates.empty())
+            return;
+
+        // sort the new fixings by date, keeping the last one for
+        // repeated dates; they usually come already sorted
+        std::vector<serial_type> newSerials;
+        std::vector<Real> newValues;
+        newSerials.reserve(dates.size());
+        newValues.reserve(dates.size());
+        auto push = [&](Size i) {
+            auto serial = serial_type(dates[i].serialNumber());
+            if (!newSerials.empty() && newSerials.back() == serial) {
+                newValues.back() = values[i];
+            } else {
+                newSerials.push_back(serial);
+                newValues.push_back(values[i]);
+            }
+        };
+        if (std::is_sorted(dates.begin(), dates.end())) {
+            for (Size i=0; i<dates.size(); ++i)
+                push(i);
+        } else {
+            std::vector<Size> order(dates.size());
+            std::iota(order.begin(), order.end(), Size(0));
+            std::stable_sort(order.begin(), order.end(),
+                             [&dates](Size i, Size j) {
+                                 return dates[i] < dates[j];
+                             });
+            for (Size i : order)
+                push(i);
+        }
+
+        detach();
+        touch();
+
+        if (serials_.empty() || newSerials.front() > serials_.back()) {
+            serials_.insert(serials_.end(),
+                            newSerials.begin(), newSerials.end());
+            values_.insert(values_.end(),
+                           newValues.begin(), newValues.end());
+            return;
+        }
+
+        lineage_ = Lineage();
+
+        std::vector<serial_type> mergedSerials;
+        std::vector<Real> mergedValues;
+        mergedSerials.reserve(serials_.size() + newSerials.size());
+        mergedValues.reserve(serials_.size() + newSerials.size());
+        Size i = 0, j = 0;
+        while (i < serials_.size() || j < newSerials.size()) {
+            if (j == newSerials.size() ||
+                (i < serials_.size() && serials_[i] < newSerials[j])) {
+                mergedSerials.push_back(serials_[i]);
+                mergedValues.push_back(values_[i]);
+                ++i;
+            } else {
+                if (i < serials_.size() && serials_[i] == newSerials[j])
+                    ++i;
+                mergedSerials.push_back(newSerials[j]);
+                mergedValues.push_back(newValues[j]);
+                ++j;
+            }
+        }
+        serials_.swap(mergedSerials);
+        values_.swap(mergedValues);
+    }
+
+    void FixingHistory::clear() {
+        serials_.clear();
+        values_.clear();
+        viewSerials_ = nullptr;
+        viewValues_ = nullptr;
+        viewSize_ = 0;
+        storage_.reset();
+        touch();
+        lineage_ = Lineage();
+    }
+
+}
@@ -0,0 +1,164 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fixinghistory.hpp
+    \brief flat storage for the past fixings of an index
+*/
+
+#ifndef quantlib_fixing_history_hpp
+#define quantlib_fixing_history_hpp
+
+#include <ql/shared_ptr.hpp>
+#include <ql/timeseries.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace QuantLib {
+
+    //! flat storage for the past fixings of an index
+    /*! Fixings are kept as two contiguous arrays of date serial
+        numbers and values, sorted by date.  Lookups use an
+        interpolation guess followed by an exponential search, which
+        takes constant time for regularly spaced (e.g., daily)
+        fixings and logarithmic time in the worst case.
+
+        The arrays can either be owned by the instance or be a
+        read-only view on external storage (e.g., a memory-mapped
+        file) kept alive by the instance; in the latter case, they
+        are copied the first time the history is modified.
+
+        \ingroup indexes
+    */
+    class FixingHistory {
+      public:
+        typedef std::int32_t serial_type;
+        FixingHistory() = default;
+        explicit FixingHistory(const TimeSeries<Real>& history);
+        /*! builds a read-only view on the given arrays, which must
+            be sorted by date and remain valid as long as the passed
+            storage is alive.
+        */
+        FixingHistory(const serial_type* serials,
+                      const Real* values,
+                      Size size,
+                      ext::shared_ptr<void> storage);
+        //! \name Inspectors
+        //@{
+        //! returns the number of stored fixings including null ones
+        Size size() const;
+        bool empty() const;
+        Date firstDate() const;
+        Date lastDate() const;
+        //! returns the (possibly null) fixing at the given date
+        Real operator[](const Date& d) const;
+        //! returns the position of the given date, or size() if absent
+        Size locate(const Date& d) const;
+        /*! returns a number identifying the contents of the history;
+            it changes whenever the history is modified, and copies
+            share the number of their source.  It can be used to
+            validate data derived from the fixings.
+        */
+        std::uint64_t revision() const;
+        /*! returns a number which is kept when fixings are appended
+            after the last stored one and changes with any other
+            modification; unlike the revision, it's not shared with
+            copies.  If the number is unchanged, the fixings stored
+            at an earlier revision are still the first ones of the
+            history, and data derived from them can be extended.
+        */
+        std::uint64_t lineage() const;
+        const serial_type* serials() const;
+        const Real* values() const;
+        std::vector<Date> dates() const;
+        //! returns a copy of the history as a time series
+        TimeSeries<Real> timeSeries() const;
+        //@}
+        //! \name Modifiers
+        //@{
+        /*! stores the given fixings, replacing the existing ones at
+            the same dates; when a date is repeated in the input,
+            the last value is kept.  Fixings following the last
+            stored one are appended; otherwise, the two sets are
+            merged in a single pass.
+        */
+        void add(const std::vector<Date>& dates,
+                 const std::vector<Real>& values);
+        void clear();
+        //@}
+      private:
+        Size find(serial_type serial) const;
+        void detach();
+        void touch();
+        // renewed when copied, since copies might then be given
+        // different fixings
+        struct Lineage {
+            Lineage();
+            Lineage(const Lineage&);
+            Lineage& operator=(const Lineage&);
+            std::uint64_t id;
+        };
+        // owned storage
+        std::vector<serial_type> serials_;
+        std::vector<Real> values_;
+        // external storage
+        const serial_type* viewSerials_ = nullptr;
+        const Real* viewValues_ = nullptr;
+        Size viewSize_ = 0;
+        ext::shared_ptr<void> storage_;
+        std::uint64_t revision_ = 0;
+        Lineage lineage_;
+    };
+
+
+    // inline definitions
+
+    inline Size FixingHistory::size() const {
+        return storage_ != nullptr ? viewSize_ : serials_.size();
+    }
+
+    inline bool FixingHistory::empty() const {
+        return size() == 0;
+    }
+
+    inline const FixingHistory::serial_type* FixingHistory::serials() const {
+        return storage_ != nullptr ? viewSerials_ : serials_.data();
+    }
+
+    inline const Real* FixingHistory::values() const {
+        return storage_ != nullptr ? viewValues_ : values_.data();
+    }
+
+    inline Real FixingHistory::operator[](const Date& d) const {
+        Size i = find(serial_type(d.serialNumber()));
+        return i != size() ? values()[i] : Null<Real>();
+    }
+
+    inline Size FixingHistory::locate(const Date& d) const {
+        return find(serial_type(d.serialNumber()));
+    }
+
+    inline std::uint64_t FixingHistory::revision() const {
+        return revision_;
+    }
+
+    inline std::uint64_t FixingHistory::lineage() const {
+        return lineage_.id;
+    }
+
+}
+
+#endif
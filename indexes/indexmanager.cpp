@@ -19,26 +19,75 @@
 
 #include <ql/indexes/indexmanager.hpp>
 #include <boost/algorithm/string/case_conv.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstring>
+#include <fstream>
 
 using boost::algorithm::to_upper_copy;
 using std::string;
 
 namespace QuantLib {
 
+    namespace {
+
+        /* Layout of the binary fixing file, with all offsets counted
+           from the start of the file and integers in native byte
+           order:
+
+           - header: magic string, byte-order mark, number of indexes;
+           - one directory entry per index;
+           - for each index, its values followed by its date serials,
+             padded to a multiple of 8 bytes;
+           - the index names.
+        */
+        const char fileMagic[8] = { 'Q', 'L', 'F', 'I', 'X', '0', '0', '1' };
+        const std::uint32_t byteOrderMark = 0x01020304;
+
+        struct FileHeader {
+            char magic[8];
+            std::uint32_t byteOrder;
+            std::uint32_t count;
+        };
+
+        struct FileEntry {
+            std::uint64_t nameOffset, nameSize;
+            std::uint64_t valuesOffset, serialsOffset, size;
+        };
+
+        std::uint64_t padded(std::uint64_t n) {
+            return (n + 7) & ~std::uint64_t(7);
+        }
+
+    }
+
+    IndexManager::History& IndexManager::history(const string& name) const {
+        return data_[to_upper_copy(name)];
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
         return data_.find(to_upper_copy(name)) != data_.end();
     }
 
     const TimeSeries<Real>& IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        const History& h = history(name);
+        if (!h.hasTimeSeries) {
+            h.timeSeries = h.fixings.timeSeries();
+            h.hasTimeSeries = true;
+        }
+        return h.timeSeries;
     }
 
     void IndexManager::setHistory(const string& name, const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        History& h = this->history(name);
+        h.fixings = FixingHistory(history);
+        if (h.hasTimeSeries)
+            h.timeSeries = history;
+        h.observable->notifyObservers();
     }
 
     ext::shared_ptr<Observable> IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        return history(name).observable;
     }
 
     std::vector<string> IndexManager::histories() const {
@@ -56,7 +105,128 @@ namespace QuantLib {
     bool IndexManager::hasHistoricalFixing(const std::string& name, const Date& fixingDate) const {
         auto const& indexIter = data_.find(to_upper_copy(name));
         return (indexIter != data_.end()) &&
-               ((*indexIter).second.value()[fixingDate] != Null<Real>());
+               ((*indexIter).second.fixings[fixingDate] != Null<Real>());
+    }
+
+    const FixingHistory& IndexManager::fixings(const string& name) const {
+        return history(name).fixings;
+    }
+
+    void IndexManager::addFixings(const string& name,
+                                  const std::vector<Date>& dates,
+                                  const std::vector<Real>& values) {
+        History& h = history(name);
+        h.fixings.add(dates, values);
+        if (h.hasTimeSeries) {
+            for (Size i=0; i<dates.size(); ++i)
+                h.timeSeries[dates[i]] = values[i];
+        }
+        h.observable->notifyObservers();
+    }
+
+    void IndexManager::saveHistories(const string& fileName) const {
+        FileHeader header;
+        std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+        header.byteOrder = byteOrderMark;
+        header.count = std::uint32_t(data_.size());
+
+        std::vector<FileEntry> entries;
+        entries.reserve(data_.size());
+        std::uint64_t offset =
+            padded(sizeof(FileHeader) + data_.size() * sizeof(FileEntry));
+        for (const auto& i : data_) {
+            FileEntry e;
+            e.size = i.second.fixings.size();
+            e.valuesOffset = offset;
+            e.serialsOffset = offset + e.size * sizeof(Real);
+            offset = padded(e.serialsOffset +
+                            e.size * sizeof(FixingHistory::serial_type));
+            entries.push_back(e);
+        }
+        Size k = 0;
+        for (const auto& i : data_) {
+            entries[k].nameOffset = offset;
+            entries[k].nameSize = i.first.size();
+            offset += i.first.size();
+            ++k;
+        }
+
+        std::ofstream out(fileName.c_str(), std::ios::out | std::ios::binary);
+        QL_REQUIRE(out.good(), "unable to open file " << fileName);
+        const char zeros[8] = {};
+        auto pad = [&]() {
+            auto written = std::uint64_t(out.tellp());
+            out.write(zeros, std::streamsize(padded(written) - written));
+        };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()),
+                  std::streamsize(entries.size() * sizeof(FileEntry)));
+        pad();
+        for (const auto& i : data_) {
+            const FixingHistory& f = i.second.fixings;
+            out.write(reinterpret_cast<const char*>(f.values()),
+                      std::streamsize(f.size() * sizeof(Real)));
+            out.write(reinterpret_cast<const char*>(f.serials()),
+                      std::streamsize(f.size() *
+                                      sizeof(FixingHistory::serial_type)));
+            pad();
+        }
+        for (const auto& i : data_)
+            out.write(i.first.data(), std::streamsize(i.first.size()));
+        QL_REQUIRE(out.good(), "unable to write file " << fileName);
+    }
+
+    void IndexManager::loadHistories(const string& fileName) {
+        namespace bip = boost::interprocess;
+        ext::shared_ptr<bip::mapped_region> region;
+        try {
+            bip::file_mapping file(fileName.c_str(), bip::read_only);
+            region = ext::make_shared<bip::mapped_region>(file, bip::read_only);
+        } catch (bip::interprocess_exception& e) {
+            QL_FAIL("unable to map file " << fileName << ": " << e.what());
+        }
+
+        const char* base = static_cast<const char*>(region->get_address());
+        std::uint64_t fileSize = region->get_size();
+
+        QL_REQUIRE(fileSize >= sizeof(FileHeader),
+                   fileName << " is not a fixing file");
+        FileHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        QL_REQUIRE(std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) == 0,
+                   fileName << " is not a fixing file");
+        QL_REQUIRE(header.byteOrder == byteOrderMark,
+                   fileName << " was written with a different byte order");
+        QL_REQUIRE(header.count <= (fileSize - sizeof(FileHeader)) / sizeof(FileEntry),
+                   fileName << " is truncated");
+
+        const auto* entries =
+            reinterpret_cast<const FileEntry*>(base + sizeof(FileHeader));
+        for (std::uint32_t i=0; i<header.count; ++i) {
+            const FileEntry& e = entries[i];
+            // written so that corrupted sizes or offsets can't overflow
+            QL_REQUIRE(e.nameOffset <= fileSize &&
+                       e.nameSize <= fileSize - e.nameOffset &&
+                       e.valuesOffset % sizeof(Real) == 0 &&
+                       e.valuesOffset <= fileSize &&
+                       e.size <= (fileSize - e.valuesOffset) / sizeof(Real) &&
+                       e.serialsOffset %
+                           sizeof(FixingHistory::serial_type) == 0 &&
+                       e.serialsOffset <= fileSize &&
+                       e.size <= (fileSize - e.serialsOffset) /
+                                     sizeof(FixingHistory::serial_type),
+                       fileName << " is corrupted");
+            string name(base + e.nameOffset, e.nameSize);
+            History& h = history(name);
+            h.fixings = FixingHistory(
+                reinterpret_cast<const FixingHistory::serial_type*>(
+                    base + e.serialsOffset),
+                reinterpret_cast<const Real*>(base + e.valuesOffset),
+                Size(e.size), region);
+            if (h.hasTimeSeries)
+                h.timeSeries = h.fixings.timeSeries();
+            h.observable->notifyObservers();
+        }
     }
 
 }
@@ -24,15 +24,24 @@
 #ifndef quantlib_index_manager_hpp
 #define quantlib_index_manager_hpp
 
+#include <ql/indexes/fixinghistory.hpp>
+#include <ql/patterns/observable.hpp>
 #include <ql/patterns/singleton.hpp>
 #include <ql/timeseries.hpp>
-#include <ql/utilities/observablevalue.hpp>
+#include <map>
 
 
 namespace QuantLib {
 
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! Fixings are stored as flat, date-sorted arrays (see
+        FixingHistory), which can also be loaded from a binary file
+        mapped in memory.  The TimeSeries returned by getHistory is
+        built the first time it is requested and is kept in sync
+        with the stored fixings afterwards.
+
+        \note index names are case insensitive
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
 
@@ -56,9 +65,36 @@ namespace QuantLib {
         void clearHistories();
         //! returns whether a specific historical fixing was stored for the index and date
         bool hasHistoricalFixing(const std::string& name, const Date& fixingDate) const;
+        //! \name Flat storage
+        //@{
+        //! returns the (possibly empty) flat history of the index fixings
+        const FixingHistory& fixings(const std::string& name) const;
+        /*! stores the given fixings, replacing existing ones at the
+            same dates, and notifies the observers of the index.
+        */
+        void addFixings(const std::string& name,
+                        const std::vector<Date>& dates,
+                        const std::vector<Real>& values);
+        //! stores all the historical fixings in a binary file
+        void saveHistories(const std::string& fileName) const;
+        /*! loads the fixings stored in a binary file written by
+            saveHistories, replacing the histories of the same
+            indexes.  The file is mapped in memory and read only
+            when the fixings are accessed; it must not be modified
+            while in use.
+        */
+        void loadHistories(const std::string& fileName);
+        //@}
 
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > > history_map;
+        struct History {
+            FixingHistory fixings;
+            ext::shared_ptr<Observable> observable = ext::make_shared<Observable>();
+            mutable TimeSeries<Real> timeSeries;
+            mutable bool hasTimeSeries = false;
+        };
+        History& history(const std::string& name) const;
+        typedef std::map<std::string, History> history_map;
         mutable history_map data_;
     };
 
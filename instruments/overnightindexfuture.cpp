@@ -44,8 +44,8 @@ namespace QuantLib {
         Handle<YieldTermStructure> forwardCurve = overnightIndex_->forwardingTermStructure();
         Real avg = 0;
         Date d1 = valueDate_;
-        const TimeSeries<Real>& history = IndexManager::instance()
-            .getHistory(overnightIndex_->name());
+        const FixingHistory& history = IndexManager::instance()
+            .fixings(overnightIndex_->name());
         Real fwd;
         while (d1 < maturityDate_) {
             Date d2 = calendar.advance(d1, 1, Days);
@@ -76,8 +76,8 @@ namespace QuantLib {
             today = calendar.adjust(today);
             // for valuations inside the reference period, index quotes
             // must have been populated in the history
-            const TimeSeries<Real>& history = IndexManager::instance()
-                .getHistory(overnightIndex_->name());
+            const FixingHistory& history = IndexManager::instance()
+                .fixings(overnightIndex_->name());
             Date d1 = valueDate_;
             while (d1 < today) {
                 Real r = history[d1];
@@ -0,0 +1,145 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/adjointreal.hpp>
+#include <ql/errors.hpp>
+#include <atomic>
+#include <ostream>
+
+namespace QuantLib {
+
+    namespace {
+
+        thread_local AdjointTape* activeTape = nullptr;
+
+        // 0 is never used, so that constants don't match any tape
+        std::atomic<std::size_t> lastRecording(0);
+
+    }
+
+    AdjointTape::AdjointTape()
+    : recording_(++lastRecording), partialsBegin_(1, 0) {}
+
+    AdjointTape::~AdjointTape() {
+        if (isActive())
+            deactivate();
+    }
+
+    void AdjointTape::activate() {
+        QL_REQUIRE(activeTape == nullptr || activeTape == this,
+                   "another tape is already active on this thread");
+        activeTape = this;
+    }
+
+    void AdjointTape::deactivate() {
+        QL_REQUIRE(activeTape == this, "tape is not active");
+        activeTape = nullptr;
+    }
+
+    bool AdjointTape::isActive() const {
+        return activeTape == this;
+    }
+
+    AdjointTape* AdjointTape::active() {
+        return activeTape;
+    }
+
+    void AdjointTape::registerInput(AdjointReal& x) {
+        QL_REQUIRE(isActive(), "tape must be active to register inputs");
+        x.index_ = record();
+        x.recording_ = recording_;
+    }
+
+    void AdjointTape::clear() {
+        recording_ = ++lastRecording;
+        partialsBegin_.resize(1);
+        operands_.clear();
+        partials_.clear();
+        adjoints_.clear();
+    }
+
+    std::size_t AdjointTape::record() {
+        partialsBegin_.push_back(operands_.size());
+        return size();
+    }
+
+    void AdjointTape::recordOperand(const AdjointReal& x, double dx) {
+        if (x.index() != 0) {
+            checkRecording(x);
+            operands_.push_back(x.index());
+            partials_.push_back(dx);
+        }
+    }
+
+    void AdjointTape::record(AdjointReal& result,
+                             const AdjointReal& x, double dx) {
+        recordOperand(x, dx);
+        result.index_ = record();
+        result.recording_ = recording_;
+    }
+
+    void AdjointTape::record(AdjointReal& result,
+                             const AdjointReal& x, double dx,
+                             const AdjointReal& y, double dy) {
+        recordOperand(x, dx);
+        recordOperand(y, dy);
+        result.index_ = record();
+        result.recording_ = recording_;
+    }
+
+    void AdjointTape::checkRecording(const AdjointReal& x) const {
+        QL_REQUIRE(x.recording() == recording_ && x.index() <= size(),
+                   "value recorded on another tape or before the tape "
+                   "was cleared");
+    }
+
+    void AdjointTape::setAdjoint(const AdjointReal& x, double adjoint) {
+        QL_REQUIRE(x.index() != 0, "value not recorded on this tape");
+        checkRecording(x);
+        adjoints_.resize(size()+1, 0.0);
+        adjoints_[x.index()] = adjoint;
+    }
+
+    double AdjointTape::adjoint(const AdjointReal& x) const {
+        if (x.index() == 0)
+            return 0.0;
+        checkRecording(x);
+        if (x.index() >= adjoints_.size())
+            return 0.0;
+        return adjoints_[x.index()];
+    }
+
+    void AdjointTape::computeAdjoints() {
+        adjoints_.resize(size()+1, 0.0);
+        for (std::size_t n=size(); n>0; --n) {
+            const double a = adjoints_[n];
+            if (a == 0.0)
+                continue;
+            for (std::size_t k=partialsBegin_[n-1]; k<partialsBegin_[n]; ++k)
+                adjoints_[operands_[k]] += partials_[k] * a;
+        }
+    }
+
+    void AdjointTape::clearAdjoints() {
+        adjoints_.assign(size()+1, 0.0);
+    }
+
+    std::ostream& operator<<(std::ostream& out, const AdjointReal& x) {
+        return out << x.value();
+    }
+
+}
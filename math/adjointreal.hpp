@@ -0,0 +1,526 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file adjointreal.hpp
+    \brief tape-based adjoint algorithmic differentiation
+*/
+
+#ifndef quantlib_adjoint_real_hpp
+#define quantlib_adjoint_real_hpp
+
+/* This header is meant to be usable as the type of Real; therefore,
+   it can't include any other QuantLib header, since they all depend
+   on Real being defined.  To build the library with it, define
+
+       QL_INCLUDE_FIRST=ql/math/adjointreal.hpp
+       QL_REAL=QuantLib::AdjointReal
+
+   when compiling both the library and client code.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <iosfwd>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace QuantLib {
+
+    class AdjointReal;
+
+    //! Tape recording operations on AdjointReal instances
+    /*! While a tape is active on a thread, each operation involving
+        an AdjointReal registered as an input (or depending on one)
+        is recorded together with its partial derivatives.  A reverse
+        sweep then propagates the adjoint of a result back to all the
+        inputs at once, i.e., it yields the full gradient at a cost
+        which is a small multiple of that of the original calculation.
+
+        \code
+        AdjointTape tape;
+        tape.activate();
+        std::vector<AdjointReal> x = ...;
+        tape.registerInputs(x.begin(), x.end());
+        AdjointReal y = f(x);
+        std::vector<Real> dydx = tape.gradient(y, x.begin(), x.end());
+        \endcode
+
+        Each recording is identified by a unique id, which changes
+        when the tape is cleared; values recorded on a different tape,
+        or before the tape was cleared, can't be used as operands nor
+        in the reverse sweep.
+
+        \warning instances are not thread-safe; each thread must use
+                 its own tape.
+    */
+    class AdjointTape {
+      public:
+        AdjointTape();
+        ~AdjointTape();
+        AdjointTape(const AdjointTape&) = delete;
+        AdjointTape& operator=(const AdjointTape&) = delete;
+        //! \name Recording
+        //@{
+        //! makes this the tape recording operations on this thread
+        void activate();
+        void deactivate();
+        bool isActive() const;
+        //! the tape recording on this thread, if any
+        static AdjointTape* active();
+        //! marks the given value as an independent variable
+        void registerInput(AdjointReal& x);
+        template <class I>
+        void registerInputs(I begin, I end) {
+            for (; begin != end; ++begin)
+                registerInput(*begin);
+        }
+        //! removes all recorded operations and starts a new recording
+        void clear();
+        //! number of recorded operations
+        std::size_t size() const { return partialsBegin_.size() - 1; }
+        //! id of the current recording
+        std::size_t recording() const { return recording_; }
+        //@}
+        //! \name Reverse sweep
+        //@{
+        void setAdjoint(const AdjointReal& x, double adjoint);
+        double adjoint(const AdjointReal& x) const;
+        //! propagates the adjoints from the results to the inputs
+        void computeAdjoints();
+        void clearAdjoints();
+        //! convenience method for the gradient of a single result
+        template <class I>
+        std::vector<double> gradient(const AdjointReal& y, I begin, I end);
+        //@}
+        //! \name Recording interface used by AdjointReal
+        //@{
+        void record(AdjointReal& result,
+                    const AdjointReal& x, double dx);
+        void record(AdjointReal& result,
+                    const AdjointReal& x, double dx,
+                    const AdjointReal& y, double dy);
+        //@}
+      private:
+        std::size_t record();
+        void recordOperand(const AdjointReal& x, double dx);
+        void checkRecording(const AdjointReal& x) const;
+        std::size_t recording_;
+        // operations are numbered from 1; 0 denotes a constant.
+        // The operands of operation n are stored in the range
+        // [partialsBegin_[n-1], partialsBegin_[n]) of operands_
+        // and partials_.
+        std::vector<std::size_t> partialsBegin_, operands_;
+        std::vector<double> partials_, adjoints_;
+    };
+
+
+    //! real number recording its operations on the active tape
+    /*! Instances which are not registered as inputs and don't depend
+        on any input behave as plain doubles and record nothing.
+    */
+    class AdjointReal {
+      public:
+        constexpr AdjointReal(double value = 0.0) : value_(value) {}
+        //! \name Inspectors
+        //@{
+        constexpr double value() const { return value_; }
+        //! index on the tape; 0 if the instance is a constant
+        constexpr std::size_t index() const { return index_; }
+        //! id of the tape recording the index refers to
+        constexpr std::size_t recording() const { return recording_; }
+        //! conversion to built-in types, e.g., Integer(x)
+        template <class T,
+                  class = typename std::enable_if<
+                                    std::is_arithmetic<T>::value>::type>
+        constexpr explicit operator T() const {
+            return static_cast<T>(value_);
+        }
+        //@}
+        //! \name Arithmetic
+        //@{
+        AdjointReal& operator+=(const AdjointReal&);
+        AdjointReal& operator-=(const AdjointReal&);
+        AdjointReal& operator*=(const AdjointReal&);
+        AdjointReal& operator/=(const AdjointReal&);
+        //@}
+        /*! \name Construction of results
+            Used by the functions below; not meant to be called by
+            client code.
+        */
+        //@{
+        static AdjointReal unary(double value,
+                                 const AdjointReal& x, double dx);
+        static AdjointReal binary(double value,
+                                  const AdjointReal& x, double dx,
+                                  const AdjointReal& y, double dy);
+        //@}
+      private:
+        friend class AdjointTape;
+        double value_;
+        std::size_t index_ = 0;
+        std::size_t recording_ = 0;
+    };
+
+
+    // inline definitions
+
+    inline AdjointReal AdjointReal::unary(double value,
+                                          const AdjointReal& x,
+                                          double dx) {
+        AdjointReal result(value);
+        if (x.index_ != 0) {
+            AdjointTape* tape = AdjointTape::active();
+            if (tape != nullptr)
+                tape->record(result, x, dx);
+        }
+        return result;
+    }
+
+    inline AdjointReal AdjointReal::binary(double value,
+                                           const AdjointReal& x, double dx,
+                                           const AdjointReal& y, double dy) {
+        AdjointReal result(value);
+        if (x.index_ != 0 || y.index_ != 0) {
+            AdjointTape* tape = AdjointTape::active();
+            if (tape != nullptr)
+                tape->record(result, x, dx, y, dy);
+        }
+        return result;
+    }
+
+    inline AdjointReal operator+(const AdjointReal& x) {
+        return x;
+    }
+
+    inline AdjointReal operator-(const AdjointReal& x) {
+        return AdjointReal::unary(-x.value(), x, -1.0);
+    }
+
+    inline AdjointReal operator+(const AdjointReal& x, const AdjointReal& y) {
+        return AdjointReal::binary(x.value()+y.value(), x, 1.0, y, 1.0);
+    }
+
+    inline AdjointReal operator+(const AdjointReal& x, double y) {
+        return AdjointReal::unary(x.value()+y, x, 1.0);
+    }
+
+    inline AdjointReal operator+(double x, const AdjointReal& y) {
+        return AdjointReal::unary(x+y.value(), y, 1.0);
+    }
+
+    inline AdjointReal operator-(const AdjointReal& x, const AdjointReal& y) {
+        return AdjointReal::binary(x.value()-y.value(), x, 1.0, y, -1.0);
+    }
+
+    inline AdjointReal operator-(const AdjointReal& x, double y) {
+        return AdjointReal::unary(x.value()-y, x, 1.0);
+    }
+
+    inline AdjointReal operator-(double x, const AdjointReal& y) {
+        return AdjointReal::unary(x-y.value(), y, -1.0);
+    }
+
+    inline AdjointReal operator*(const AdjointReal& x, const AdjointReal& y) {
+        return AdjointReal::binary(x.value()*y.value(),
+                                   x, y.value(), y, x.value());
+    }
+
+    inline AdjointReal operator*(const AdjointReal& x, double y) {
+        return AdjointReal::unary(x.value()*y, x, y);
+    }
+
+    inline AdjointReal operator*(double x, const AdjointReal& y) {
+        return AdjointReal::unary(x*y.value(), y, x);
+    }
+
+    inline AdjointReal operator/(const AdjointReal& x, const AdjointReal& y) {
+        double inverse = 1.0/y.value();
+        double result = x.value()*inverse;
+        return AdjointReal::binary(result, x, inverse, y, -result*inverse);
+    }
+
+    inline AdjointReal operator/(const AdjointReal& x, double y) {
+        return AdjointReal::unary(x.value()/y, x, 1.0/y);
+    }
+
+    inline AdjointReal operator/(double x, const AdjointReal& y) {
+        double result = x/y.value();
+        return AdjointReal::unary(result, y, -result/y.value());
+    }
+
+    inline AdjointReal& AdjointReal::operator+=(const AdjointReal& x) {
+        return *this = *this + x;
+    }
+
+    inline AdjointReal& AdjointReal::operator-=(const AdjointReal& x) {
+        return *this = *this - x;
+    }
+
+    inline AdjointReal& AdjointReal::operator*=(const AdjointReal& x) {
+        return *this = *this * x;
+    }
+
+    inline AdjointReal& AdjointReal::operator/=(const AdjointReal& x) {
+        return *this = *this / x;
+    }
+
+    #define QL_ADJOINT_COMPARISON(OP) \
+    inline bool operator OP(const AdjointReal& x, const AdjointReal& y) { \
+        return x.value() OP y.value(); \
+    } \
+    inline bool operator OP(const AdjointReal& x, double y) { \
+        return x.value() OP y; \
+    } \
+    inline bool operator OP(double x, const AdjointReal& y) { \
+        return x OP y.value(); \
+    }
+
+    QL_ADJOINT_COMPARISON(==)
+    QL_ADJOINT_COMPARISON(!=)
+    QL_ADJOINT_COMPARISON(<)
+    QL_ADJOINT_COMPARISON(<=)
+    QL_ADJOINT_COMPARISON(>)
+    QL_ADJOINT_COMPARISON(>=)
+
+    #undef QL_ADJOINT_COMPARISON
+
+    inline AdjointReal exp(const AdjointReal& x) {
+        double result = std::exp(x.value());
+        return AdjointReal::unary(result, x, result);
+    }
+
+    inline AdjointReal log(const AdjointReal& x) {
+        return AdjointReal::unary(std::log(x.value()), x, 1.0/x.value());
+    }
+
+    inline AdjointReal log10(const AdjointReal& x) {
+        return AdjointReal::unary(std::log10(x.value()), x,
+                                  1.0/(x.value()*std::log(10.0)));
+    }
+
+    inline AdjointReal sqrt(const AdjointReal& x) {
+        double result = std::sqrt(x.value());
+        return AdjointReal::unary(result, x, 0.5/result);
+    }
+
+    inline AdjointReal pow(const AdjointReal& x, const AdjointReal& y) {
+        double result = std::pow(x.value(), y.value());
+        double dy = x.value() > 0.0 ? result*std::log(x.value()) : 0.0;
+        return AdjointReal::binary(
+            result, x, y.value()*std::pow(x.value(), y.value()-1.0), y, dy);
+    }
+
+    inline AdjointReal pow(const AdjointReal& x, double y) {
+        return AdjointReal::unary(std::pow(x.value(), y), x,
+                                  y*std::pow(x.value(), y-1.0));
+    }
+
+    inline AdjointReal pow(double x, const AdjointReal& y) {
+        double result = std::pow(x, y.value());
+        return AdjointReal::unary(result, y,
+                                  x > 0.0 ? result*std::log(x) : 0.0);
+    }
+
+    inline AdjointReal fabs(const AdjointReal& x) {
+        return AdjointReal::unary(std::fabs(x.value()), x,
+                                  x.value() < 0.0 ? -1.0 : 1.0);
+    }
+
+    inline AdjointReal abs(const AdjointReal& x) {
+        return fabs(x);
+    }
+
+    inline AdjointReal sin(const AdjointReal& x) {
+        return AdjointReal::unary(std::sin(x.value()), x,
+                                  std::cos(x.value()));
+    }
+
+    inline AdjointReal cos(const AdjointReal& x) {
+        return AdjointReal::unary(std::cos(x.value()), x,
+                                  -std::sin(x.value()));
+    }
+
+    inline AdjointReal tan(const AdjointReal& x) {
+        double result = std::tan(x.value());
+        return AdjointReal::unary(result, x, 1.0 + result*result);
+    }
+
+    inline AdjointReal atan(const AdjointReal& x) {
+        return AdjointReal::unary(std::atan(x.value()), x,
+                                  1.0/(1.0 + x.value()*x.value()));
+    }
+
+    inline AdjointReal sinh(const AdjointReal& x) {
+        return AdjointReal::unary(std::sinh(x.value()), x,
+                                  std::cosh(x.value()));
+    }
+
+    inline AdjointReal cosh(const AdjointReal& x) {
+        return AdjointReal::unary(std::cosh(x.value()), x,
+                                  std::sinh(x.value()));
+    }
+
+    inline AdjointReal tanh(const AdjointReal& x) {
+        double result = std::tanh(x.value());
+        return AdjointReal::unary(result, x, 1.0 - result*result);
+    }
+
+    inline AdjointReal erf(const AdjointReal& x) {
+        // 2/sqrt(pi)
+        const double factor = 1.12837916709551257390;
+        return AdjointReal::unary(std::erf(x.value()), x,
+                                  factor*std::exp(-x.value()*x.value()));
+    }
+
+    inline AdjointReal erfc(const AdjointReal& x) {
+        const double factor = 1.12837916709551257390;
+        return AdjointReal::unary(std::erfc(x.value()), x,
+                                  -factor*std::exp(-x.value()*x.value()));
+    }
+
+    // piecewise-constant functions; their derivative is null
+    inline AdjointReal floor(const AdjointReal& x) {
+        return AdjointReal(std::floor(x.value()));
+    }
+
+    inline AdjointReal ceil(const AdjointReal& x) {
+        return AdjointReal(std::ceil(x.value()));
+    }
+
+    inline AdjointReal (min)(const AdjointReal& x, const AdjointReal& y) {
+        return y < x ? y : x;
+    }
+
+    inline AdjointReal (max)(const AdjointReal& x, const AdjointReal& y) {
+        return x < y ? y : x;
+    }
+
+    // mixed overloads, so that calls such as std::max(x, 0.0) compile
+    inline AdjointReal (min)(const AdjointReal& x, double y) {
+        return (min)(x, AdjointReal(y));
+    }
+
+    inline AdjointReal (min)(double x, const AdjointReal& y) {
+        return (min)(AdjointReal(x), y);
+    }
+
+    inline AdjointReal (max)(const AdjointReal& x, double y) {
+        return (max)(x, AdjointReal(y));
+    }
+
+    inline AdjointReal (max)(double x, const AdjointReal& y) {
+        return (max)(AdjointReal(x), y);
+    }
+
+    inline bool isnan(const AdjointReal& x) {
+        return std::isnan(x.value());
+    }
+
+    inline bool isinf(const AdjointReal& x) {
+        return std::isinf(x.value());
+    }
+
+    inline bool isfinite(const AdjointReal& x) {
+        return std::isfinite(x.value());
+    }
+
+    std::ostream& operator<<(std::ostream&, const AdjointReal&);
+
+
+    template <class I>
+    std::vector<double> AdjointTape::gradient(const AdjointReal& y,
+                                              I begin, I end) {
+        clearAdjoints();
+        setAdjoint(y, 1.0);
+        computeAdjoints();
+        std::vector<double> result;
+        for (; begin != end; ++begin)
+            result.push_back(adjoint(*begin));
+        return result;
+    }
+
+}
+
+/* Client code and the library call the math functions as, e.g.,
+   std::exp; the overloads above are made available in namespace std
+   as well.  This is the usual practice for operator-overloading AD
+   tools, even though it is not sanctioned by the standard.
+*/
+namespace std {
+
+    using QuantLib::exp;
+    using QuantLib::log;
+    using QuantLib::log10;
+    using QuantLib::sqrt;
+    using QuantLib::pow;
+    using QuantLib::fabs;
+    using QuantLib::abs;
+    using QuantLib::sin;
+    using QuantLib::cos;
+    using QuantLib::tan;
+    using QuantLib::atan;
+    using QuantLib::sinh;
+    using QuantLib::cosh;
+    using QuantLib::tanh;
+    using QuantLib::erf;
+    using QuantLib::erfc;
+    using QuantLib::floor;
+    using QuantLib::ceil;
+    using QuantLib::min;
+    using QuantLib::max;
+    using QuantLib::isnan;
+    using QuantLib::isinf;
+    using QuantLib::isfinite;
+
+    template <>
+    class numeric_limits<QuantLib::AdjointReal>
+        : public numeric_limits<double> {
+      public:
+        static constexpr QuantLib::AdjointReal (min)() {
+            return (numeric_limits<double>::min)();
+        }
+        static constexpr QuantLib::AdjointReal (max)() {
+            return (numeric_limits<double>::max)();
+        }
+        static constexpr QuantLib::AdjointReal lowest() {
+            return numeric_limits<double>::lowest();
+        }
+        static constexpr QuantLib::AdjointReal epsilon() {
+            return numeric_limits<double>::epsilon();
+        }
+        static constexpr QuantLib::AdjointReal round_error() {
+            return numeric_limits<double>::round_error();
+        }
+        static constexpr QuantLib::AdjointReal infinity() {
+            return numeric_limits<double>::infinity();
+        }
+        static constexpr QuantLib::AdjointReal quiet_NaN() {
+            return numeric_limits<double>::quiet_NaN();
+        }
+        static constexpr QuantLib::AdjointReal signaling_NaN() {
+            return numeric_limits<double>::signaling_NaN();
+        }
+        static constexpr QuantLib::AdjointReal denorm_min() {
+            return numeric_limits<double>::denorm_min();
+        }
+    };
+
+}
+
+
+#endif
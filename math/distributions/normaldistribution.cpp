@@ -54,6 +54,13 @@ namespace QuantLib {
         return result;
     }
 
+    void CumulativeNormalDistribution::transform(const Real* in,
+                                                 Real* out,
+                                                 Size n) const {
+        for (Size i=0; i<n; ++i)
+            out[i] = (*this)(in[i]);
+    }
+
     #if !defined(QL_PATCH_SOLARIS)
     const CumulativeNormalDistribution InverseCumulativeNormal::f_;
     #endif
@@ -117,6 +124,38 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::transform(const Real* in,
+                                            Real* out,
+                                            Size n) const {
+        // central region for all points; no branches in the loop
+        for (Size i=0; i<n; ++i) {
+            Real z = in[i] - 0.5;
+            Real r = z*z;
+            out[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+        }
+
+        // tails, same test as in standard_value
+        for (Size i=0; i<n; ++i) {
+            if (in[i] < x_low_ || x_high_ < in[i])
+                out[i] = tail_value(in[i]);
+        }
+
+        #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+        for (Size i=0; i<n; ++i) {
+            const Real z = out[i];
+            const Real r =
+                (f_(z) - in[i]) * M_SQRT2 * M_SQRTPI * exp(0.5 * z*z);
+            out[i] = z - r/(1+0.5*z*r);
+        }
+        #endif
+
+        if (average_ != 0.0 || sigma_ != 1.0) {
+            for (Size i=0; i<n; ++i)
+                out[i] = average_ + sigma_*out[i];
+        }
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
@@ -96,6 +96,11 @@ namespace QuantLib {
         // function
         Real operator()(Real x) const;
         Real derivative(Real x) const;
+        /*! sets out[i] to the value of the distribution at in[i]
+            for i = 0...n-1.  The results are the same as those
+            returned by operator(); in and out may coincide.
+        */
+        void transform(const Real* in, Real* out, Size n) const;
       private:
         Real average_, sigma_;
         NormalDistribution gaussian_;
@@ -170,6 +175,20 @@ namespace QuantLib {
 
             return z;
         }
+        /*! sets out[i] to the value of the inverse distribution at
+            in[i] for i = 0...n-1.
+
+            The central region is computed for all the inputs in a
+            branch-free loop that the compiler can vectorize; the
+            few inputs falling in the tails are corrected afterwards.
+            The results are the same as those returned by operator(),
+            i.e., the difference is 0 ulp, as long as the compiler
+            doesn't contract the two loops into fused multiply-adds
+            differently.
+
+            \pre in and out must not overlap.
+        */
+        void transform(const Real* in, Real* out, Size n) const;
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
@@ -27,6 +27,7 @@
 #define quantlib_interpolation_hpp
 
 #include <ql/math/interpolations/extrapolation.hpp>
+#include <ql/math/interpolations/segmentlocator.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/errors.hpp>
 #include <vector>
@@ -68,6 +69,8 @@ namespace QuantLib {
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
+            //! called after update() to account for changes in the grid
+            virtual void updateLocator() {}
         };
         ext::shared_ptr<Impl> impl_;
       public:
@@ -89,7 +92,8 @@ namespace QuantLib {
           public:
             templateImpl(const I1& xBegin, const I1& xEnd, const I2& yBegin,
                          const int requiredPoints = 2)
-            : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin) {
+            : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin),
+              locator_(xBegin, xEnd) {
                 QL_REQUIRE(static_cast<int>(xEnd_-xBegin_) >= requiredPoints,
                            "not enough points to interpolate: at least " <<
                            requiredPoints <<
@@ -116,15 +120,13 @@ namespace QuantLib {
                 for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
                     QL_REQUIRE(*j > *i, "unsorted x values");
                 #endif
-                if (x < *xBegin_)
-                    return 0;
-                else if (x > *(xEnd_-1))
-                    return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                return locator_(x);
             }
+            void updateLocator() override { locator_.update(); }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
+          private:
+            detail::SegmentLocator<I1> locator_;
         };
 
         Interpolation() = default;
@@ -157,6 +159,7 @@ namespace QuantLib {
         }
         void update() {
             impl_->update();
+            impl_->updateLocator();
         }
       protected:
         void checkRange(Real x, bool extrapolate) const {
@@ -21,5 +21,6 @@
 #include <ql/math/interpolations/mixedinterpolation.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
+#include <ql/math/interpolations/segmentlocator.hpp>
 #include <ql/math/interpolations/xabrinterpolation.hpp>
 
@@ -26,6 +26,7 @@
 #define quantlib_interpolation2D_hpp
 
 #include <ql/math/interpolations/extrapolation.hpp>
+#include <ql/math/interpolations/segmentlocator.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/errors.hpp>
@@ -62,6 +63,8 @@ namespace QuantLib {
             virtual const Matrix& zData() const = 0;
             virtual bool isInRange(Real x, Real y) const = 0;
             virtual Real value(Real x, Real y) const = 0;
+            //! called after calculate() to account for changes in the grids
+            virtual void updateLocators() {}
         };
         ext::shared_ptr<Impl> impl_;
       public:
@@ -90,7 +93,7 @@ namespace QuantLib {
                          const I2& yBegin, const I2& yEnd,
                          const M& zData)
             : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin), yEnd_(yEnd),
-              zData_(zData) {
+              zData_(zData), xLocator_(xBegin, xEnd), yLocator_(yBegin, yEnd) {
                 QL_REQUIRE(xEnd_-xBegin_ >= 2,
                            "not enough x points to interpolate: at least 2 "
                            "required, " << xEnd_-xBegin_ << " provided");
@@ -130,28 +133,25 @@ namespace QuantLib {
                 for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
                     QL_REQUIRE(*j > *i, "unsorted x values");
                 #endif
-                if (x < *xBegin_)
-                    return 0;
-                else if (x > *(xEnd_-1))
-                    return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                return xLocator_(x);
             }
             Size locateY(Real y) const override {
 #if defined(QL_EXTRA_SAFETY_CHECKS)
                 for (I2 k=yBegin_, l=yBegin_+1; l!=yEnd_; ++k, ++l)
                     QL_REQUIRE(*l > *k, "unsorted y values");
                 #endif
-                if (y < *yBegin_)
-                    return 0;
-                else if (y > *(yEnd_-1))
-                    return yEnd_-yBegin_-2;
-                else
-                    return std::upper_bound(yBegin_,yEnd_-1,y)-yBegin_-1;
+                return yLocator_(y);
+            }
+            void updateLocators() override {
+                xLocator_.update();
+                yLocator_.update();
             }
             I1 xBegin_, xEnd_;
             I2 yBegin_, yEnd_;
             const M& zData_;
+          private:
+            detail::SegmentLocator<I1> xLocator_;
+            detail::SegmentLocator<I2> yLocator_;
         };
 
         Interpolation2D() = default;
@@ -192,6 +192,7 @@ namespace QuantLib {
         }
         void update() {
             impl_->calculate();
+            impl_->updateLocators();
         }
       protected:
         void checkRange(Real x, Real y, bool extrapolate) const {
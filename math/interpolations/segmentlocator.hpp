@@ -0,0 +1,142 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file segmentlocator.hpp
+    \brief fast lookup of the interpolation segment containing a point
+*/
+
+#ifndef quantlib_segment_locator_hpp
+#define quantlib_segment_locator_hpp
+
+#include <ql/types.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! locates the segment of a sorted grid containing a point
+        /*! The result is the same as that of a binary search, i.e.,
+            the index \f$ i \f$ of the last grid point \f$ x_i \le x
+            \f$ among the first \f$ n-1 \f$, with points outside the
+            grid mapped to the first and last segment.  However:
+            - the segment found by the last search and the one after
+              it are tried first, which makes lookups O(1) when points
+              are queried in increasing order, as when pricing cash
+              flows on a curve;
+            - on larger grids, an index of uniform buckets narrows the
+              search down to the few segments overlapping the bucket
+              of the point.
+
+            Each candidate segment is checked before being returned,
+            so that an outdated hint or index (e.g., if the grid was
+            changed without calling update()) can only make the search
+            slower, not wrong.
+        */
+        template <class I>
+        class SegmentLocator {
+          public:
+            //! grids smaller than this are not indexed
+            static const Size minIndexedPoints = 16;
+
+            SegmentLocator(const I& begin, const I& end)
+            : begin_(begin), end_(end), hint_(0) {
+                update();
+            }
+            SegmentLocator(const SegmentLocator& other)
+            : begin_(other.begin_), end_(other.end_), hint_(0),
+              buckets_(other.buckets_), x0_(other.x0_),
+              scale_(other.scale_) {}
+            SegmentLocator& operator=(const SegmentLocator&) = delete;
+
+            //! rebuilds the index; to be called when the grid changes
+            void update() {
+                buckets_.clear();
+                Size n = end_ - begin_;
+                if (n < minIndexedPoints)
+                    return;
+                x0_ = begin_[0];
+                Real width = begin_[n-1] - x0_;
+                if (!(width > 0.0) || !std::isfinite(width))
+                    return;
+                // as many buckets as segments; bucket b starts in
+                // segment buckets_[b] and ends in buckets_[b+1]
+                Size nBuckets = n-1;
+                scale_ = nBuckets / width;
+                buckets_.resize(nBuckets+1);
+                Size k = 0;
+                for (Size b=0; b<=nBuckets; ++b) {
+                    Real x = x0_ + b / scale_;
+                    while (k < n-2 && begin_[k+1] <= x)
+                        ++k;
+                    buckets_[b] = k;
+                }
+            }
+
+            Size operator()(Real x) const {
+                Size n = end_ - begin_;
+                if (x < begin_[0])
+                    return 0;
+                else if (x > begin_[n-1])
+                    return n-2;
+
+                Size k = hint_.load(std::memory_order_relaxed);
+                if (contains(k, x, n))
+                    return k;
+                if (contains(k+1, x, n)) {
+                    hint_.store(k+1, std::memory_order_relaxed);
+                    return k+1;
+                }
+
+                k = n;
+                if (!buckets_.empty()) {
+                    Real position = (x - x0_) * scale_;
+                    if (position >= 0.0) {
+                        Size b = std::min<Size>(Size(position),
+                                                buckets_.size()-2);
+                        k = std::upper_bound(begin_ + (buckets_[b] + 1),
+                                             begin_ + (buckets_[b+1] + 1),
+                                             x) - begin_ - 1;
+                    }
+                }
+                if (!contains(k, x, n))
+                    k = std::upper_bound(begin_, end_-1, x) - begin_ - 1;
+
+                hint_.store(k, std::memory_order_relaxed);
+                return k;
+            }
+
+          private:
+            bool contains(Size k, Real x, Size n) const {
+                return k <= n-2 && begin_[k] <= x &&
+                       (k == n-2 || x < begin_[k+1]);
+            }
+            I begin_, end_;
+            mutable std::atomic<Size> hint_;
+            std::vector<Size> buckets_;
+            Real x0_ = 0.0, scale_ = 0.0;
+        };
+
+    }
+
+}
+
+
+#endif
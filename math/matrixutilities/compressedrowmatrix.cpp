@@ -0,0 +1,164 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    CompressedRowMatrix::CompressedRowMatrix(const SparseMatrix& m)
+    : rows_(m.size1()), columns_(m.size2()), rowStart_(m.size1()+1, 0) {
+
+        // ublas leaves the index of trailing empty rows unfilled
+        const Size filled = std::min<Size>(m.filled1(), rows_+1);
+        const Size nnz = (filled > 0) ? Size(m.index1_data()[filled-1]) : 0;
+        for (Size i=0; i < filled; ++i)
+            rowStart_[i] = m.index1_data()[i];
+        std::fill(rowStart_.begin()+std::max<Size>(filled, 1),
+                  rowStart_.end(), nnz);
+
+        columnIndex_.assign(m.index2_data().begin(),
+                            m.index2_data().begin()+nnz);
+        values_.assign(m.value_data().begin(),
+                       m.value_data().begin()+nnz);
+    }
+
+    CompressedRowMatrix::CompressedRowMatrix(Size rows,
+                                             Size columns,
+                                             std::vector<Size> rowStart,
+                                             std::vector<Size> columnIndex,
+                                             std::vector<Real> values)
+    : rows_(rows), columns_(columns), rowStart_(std::move(rowStart)),
+      columnIndex_(std::move(columnIndex)), values_(std::move(values)) {
+
+        QL_REQUIRE(rowStart_.size() == rows_+1,
+                   "row start vector of size " << rows_+1
+                   << " required, " << rowStart_.size() << " given");
+        QL_REQUIRE(rowStart_.front() == 0
+                   && rowStart_.back() == values_.size(),
+                   "inconsistent row start vector");
+        QL_REQUIRE(columnIndex_.size() == values_.size(),
+                   "column indices and values differ in size");
+
+        for (Size i=0; i < rows_; ++i) {
+            QL_REQUIRE(rowStart_[i] <= rowStart_[i+1],
+                       "decreasing row start at row " << i);
+            for (Size k=rowStart_[i]; k < rowStart_[i+1]; ++k) {
+                QL_REQUIRE(columnIndex_[k] < columns_,
+                           "column index " << columnIndex_[k]
+                           << " out of range in row " << i);
+                QL_REQUIRE(k == rowStart_[i]
+                           || columnIndex_[k-1] < columnIndex_[k],
+                           "column indices not increasing in row " << i);
+            }
+        }
+    }
+
+    Size CompressedRowMatrix::position(Size i, Size j) const {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "entry (" << i << "," << j << ") out of range");
+
+        const auto begin = columnIndex_.begin() + rowStart_[i];
+        const auto end = columnIndex_.begin() + rowStart_[i+1];
+        const auto iter = std::lower_bound(begin, end, j);
+
+        return (iter != end && *iter == j)
+            ? Size(iter - columnIndex_.begin()) : nonZeros();
+    }
+
+    Real CompressedRowMatrix::operator()(Size i, Size j) const {
+        const Size k = position(i, j);
+        return (k != nonZeros()) ? values_[k] : 0.0;
+    }
+
+    Array CompressedRowMatrix::diagonal() const {
+        Array d(std::min(rows_, columns_));
+        for (Size i=0; i < d.size(); ++i)
+            d[i] = (*this)(i, i);
+        return d;
+    }
+
+    Array prod(const CompressedRowMatrix& A, const Array& x) {
+        QL_REQUIRE(x.size() == A.columns(),
+                   "vectors and sparse matrices with different sizes ("
+                   << x.size() << ", " << A.rows() << "x" << A.columns() <<
+                   ") cannot be multiplied");
+
+        const Size* rowStart = A.rowStart().data();
+        const Size* columnIndex = A.columnIndex().data();
+        const Real* values = A.values().data();
+        const Real* xptr = x.begin();
+
+        Array b(A.rows());
+        Real* bptr = b.begin();
+
+        #pragma omp parallel for
+        for (long i=0; i < (long)A.rows(); ++i) {
+            Real t = 0.0;
+            for (Size k=rowStart[i]; k < rowStart[i+1]; ++k)
+                t += values[k]*xptr[columnIndex[k]];
+            bptr[i] = t;
+        }
+
+        return b;
+    }
+
+    CompressedRowMatrix operator+(const CompressedRowMatrix& A,
+                                  const CompressedRowMatrix& B) {
+        QL_REQUIRE(A.rows() == B.rows() && A.columns() == B.columns(),
+                   "sparse matrices with different sizes ("
+                   << A.rows() << "x" << A.columns() << ", "
+                   << B.rows() << "x" << B.columns() << ") cannot be added");
+
+        const std::vector<Size>& aStart = A.rowStart();
+        const std::vector<Size>& bStart = B.rowStart();
+        const std::vector<Size>& aColumns = A.columnIndex();
+        const std::vector<Size>& bColumns = B.columnIndex();
+        const std::vector<Real>& aValues = A.values();
+        const std::vector<Real>& bValues = B.values();
+
+        std::vector<Size> rowStart(A.rows()+1, 0), columns;
+        std::vector<Real> values;
+        columns.reserve(A.nonZeros()+B.nonZeros());
+        values.reserve(A.nonZeros()+B.nonZeros());
+
+        for (Size i=0; i < A.rows(); ++i) {
+            Size ka = aStart[i], kb = bStart[i];
+            while (ka < aStart[i+1] || kb < bStart[i+1]) {
+                if (kb == bStart[i+1]
+                    || (ka < aStart[i+1] && aColumns[ka] < bColumns[kb])) {
+                    columns.push_back(aColumns[ka]);
+                    values.push_back(aValues[ka++]);
+                }
+                else if (ka == aStart[i+1] || bColumns[kb] < aColumns[ka]) {
+                    columns.push_back(bColumns[kb]);
+                    values.push_back(bValues[kb++]);
+                }
+                else {
+                    columns.push_back(aColumns[ka]);
+                    values.push_back(aValues[ka++] + bValues[kb++]);
+                }
+            }
+            rowStart[i+1] = columns.size();
+        }
+
+        return {A.rows(), A.columns(), std::move(rowStart),
+                std::move(columns), std::move(values)};
+    }
+
+}
@@ -0,0 +1,85 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compressedrowmatrix.hpp
+    \brief sparse matrix in compressed row storage
+*/
+
+#ifndef quantlib_compressed_row_matrix_hpp
+#define quantlib_compressed_row_matrix_hpp
+
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! sparse matrix in compressed row storage
+    /*! The entries of row i are stored at the positions
+        rowStart()[i], ..., rowStart()[i+1]-1 of columnIndex() and
+        values(), with increasing column indices. The sparsity
+        pattern is fixed after construction, while the values can be
+        modified in place; this allows to re-assemble a matrix with
+        the same structure without reallocating.
+    */
+    class CompressedRowMatrix {
+      public:
+        CompressedRowMatrix() = default;
+        //! copies the compressed storage of a ublas matrix
+        explicit CompressedRowMatrix(const SparseMatrix& m);
+        /*! the column indices within each row must be strictly
+            increasing.
+        */
+        CompressedRowMatrix(Size rows,
+                            Size columns,
+                            std::vector<Size> rowStart,
+                            std::vector<Size> columnIndex,
+                            std::vector<Real> values);
+
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rows_; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+
+        const std::vector<Size>& rowStart() const { return rowStart_; }
+        const std::vector<Size>& columnIndex() const { return columnIndex_; }
+        const std::vector<Real>& values() const { return values_; }
+        std::vector<Real>& values() { return values_; }
+
+        //! position of the entry (i,j) in values(), nonZeros() if not stored
+        Size position(Size i, Size j) const;
+        //! entry (i,j), zero if it is not stored
+        Real operator()(Size i, Size j) const;
+        Array diagonal() const;
+        //@}
+
+      private:
+        Size rows_ = 0, columns_ = 0;
+        std::vector<Size> rowStart_, columnIndex_;
+        std::vector<Real> values_;
+    };
+
+    //! sparse matrix-vector product
+    Array prod(const CompressedRowMatrix& A, const Array& x);
+
+    //! sum of two matrices on the union of their sparsity patterns
+    CompressedRowMatrix operator+(const CompressedRowMatrix& A,
+                                  const CompressedRowMatrix& B);
+
+}
+
+#endif
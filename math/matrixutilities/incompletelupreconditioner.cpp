@@ -0,0 +1,96 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/incompletelupreconditioner.hpp>
+
+namespace QuantLib {
+
+    IncompleteLUPreconditioner::IncompleteLUPreconditioner(
+        const CompressedRowMatrix& A)
+    : lu_(A), diagonal_(A.rows()), inverseDiagonal_(A.rows()) {
+
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "incomplete LU preconditioner works only "
+                   "with square matrices");
+
+        const Size n = lu_.rows();
+        const std::vector<Size>& rowStart = lu_.rowStart();
+        const std::vector<Size>& columnIndex = lu_.columnIndex();
+        std::vector<Real>& v = lu_.values();
+
+        for (Size i=0; i < n; ++i) {
+            diagonal_[i] = lu_.position(i, i);
+            QL_REQUIRE(diagonal_[i] != lu_.nonZeros(),
+                       "missing diagonal entry in row " << i);
+        }
+
+        // positions of the entries of the current row by column,
+        // lu_.nonZeros() for columns outside of its pattern
+        std::vector<Size> positions(n, lu_.nonZeros());
+
+        for (Size i=0; i < n; ++i) {
+            for (Size k=rowStart[i]; k < rowStart[i+1]; ++k)
+                positions[columnIndex[k]] = k;
+
+            for (Size k=rowStart[i]; k < diagonal_[i]; ++k) {
+                const Size j = columnIndex[k];
+                const Real l = (v[k] *= inverseDiagonal_[j]);
+
+                for (Size m=diagonal_[j]+1; m < rowStart[j+1]; ++m) {
+                    const Size p = positions[columnIndex[m]];
+                    if (p != lu_.nonZeros())
+                        v[p] -= l*v[m];
+                }
+            }
+
+            const Real d = v[diagonal_[i]];
+            QL_REQUIRE(d != 0.0, "zero pivot in row " << i);
+            inverseDiagonal_[i] = 1.0/d;
+
+            for (Size k=rowStart[i]; k < rowStart[i+1]; ++k)
+                positions[columnIndex[k]] = lu_.nonZeros();
+        }
+    }
+
+    Array IncompleteLUPreconditioner::apply(const Array& b) const {
+        const Size n = lu_.rows();
+        QL_REQUIRE(b.size() == n,
+                   "vector of size " << n << " required, "
+                   << b.size() << " given");
+
+        const std::vector<Size>& rowStart = lu_.rowStart();
+        const std::vector<Size>& columnIndex = lu_.columnIndex();
+        const std::vector<Real>& v = lu_.values();
+
+        Array x(n);
+        for (Size i=0; i < n; ++i) {
+            Real t = b[i];
+            for (Size k=rowStart[i]; k < diagonal_[i]; ++k)
+                t -= v[k]*x[columnIndex[k]];
+            x[i] = t;
+        }
+        for (Size i=n; i > 0; --i) {
+            Real t = x[i-1];
+            for (Size k=diagonal_[i-1]+1; k < rowStart[i]; ++k)
+                t -= v[k]*x[columnIndex[k]];
+            x[i-1] = t*inverseDiagonal_[i-1];
+        }
+
+        return x;
+    }
+
+}
@@ -0,0 +1,63 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file incompletelupreconditioner.hpp
+    \brief ILU(0) preconditioner on compressed row storage
+*/
+
+#ifndef quantlib_incomplete_lu_preconditioner_hpp
+#define quantlib_incomplete_lu_preconditioner_hpp
+
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
+
+namespace QuantLib {
+
+    //! incomplete LU factorization without fill-in
+    /*! The factors L and U share the sparsity pattern of A: the
+        strictly lower part holds L (with unit diagonal), the upper
+        part holds U. Building the factorization costs a few sparse
+        matrix-vector products, hence it can be reused over many
+        solves with the same or a slowly varying matrix.
+
+        Unlike SparseILUPreconditioner, which implements ILU(k) on
+        ublas matrices with dense row work arrays, this class scales
+        linearly with the number of non-zero entries and is meant for
+        large finite-difference grids.
+
+        References:
+        Saad, Yousef. 1996, Iterative methods for sparse linear systems,
+        http://www-users.cs.umn.edu/~saad/books.html, section 10.3
+    */
+    class IncompleteLUPreconditioner {
+      public:
+        explicit IncompleteLUPreconditioner(const CompressedRowMatrix& A);
+
+        //! returns \f$ U^{-1} L^{-1} b \f$
+        Array apply(const Array& b) const;
+
+        //! both factors in the sparsity pattern of A
+        const CompressedRowMatrix& LU() const { return lu_; }
+
+      private:
+        CompressedRowMatrix lu_;
+        std::vector<Size> diagonal_;
+        std::vector<Real> inverseDiagonal_;
+    };
+
+}
+
+#endif
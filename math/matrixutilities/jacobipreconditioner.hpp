@@ -0,0 +1,57 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file jacobipreconditioner.hpp
+    \brief diagonal (Jacobi) preconditioner
+*/
+
+#ifndef quantlib_jacobi_preconditioner_hpp
+#define quantlib_jacobi_preconditioner_hpp
+
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
+
+namespace QuantLib {
+
+    //! preconditioner using the inverse of the diagonal of A
+    class JacobiPreconditioner {
+      public:
+        explicit JacobiPreconditioner(const CompressedRowMatrix& A)
+        : inverseDiagonal_(A.diagonal()) {
+            QL_REQUIRE(A.rows() == A.columns(),
+                       "Jacobi preconditioner works only "
+                       "with square matrices");
+            for (Size i=0; i < inverseDiagonal_.size(); ++i) {
+                QL_REQUIRE(inverseDiagonal_[i] != 0.0,
+                           "zero diagonal entry in row " << i);
+                inverseDiagonal_[i] = 1.0/inverseDiagonal_[i];
+            }
+        }
+
+        Array apply(const Array& b) const {
+            QL_REQUIRE(b.size() == inverseDiagonal_.size(),
+                       "vector of size " << inverseDiagonal_.size()
+                       << " required, " << b.size() << " given");
+            return b*inverseDiagonal_;
+        }
+
+      private:
+        Array inverseDiagonal_;
+    };
+
+}
+
+#endif
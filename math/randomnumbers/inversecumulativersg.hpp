@@ -26,11 +26,38 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // uses IC::transform when available...
+        template <class IC>
+        inline auto inverseCumulativeTransform(const IC& ic,
+                                               const Real* in,
+                                               Real* out,
+                                               Size n,
+                                               int)
+        -> decltype(ic.transform(in, out, n), void()) {
+            ic.transform(in, out, n);
+        }
+
+        // ...and falls back to IC::operator() otherwise
+        template <class IC>
+        inline void inverseCumulativeTransform(const IC& ic,
+                                               const Real* in,
+                                               Real* out,
+                                               Size n,
+                                               long) {
+            for (Size i = 0; i < n; i++)
+                out[i] = ic(in[i]);
+        }
+
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -52,6 +79,11 @@ namespace QuantLib {
             IC::IC();
             Real IC::operator() const;
         \endcode
+        If IC also implements
+        \code
+            void IC::transform(const Real* in, Real* out, Size n) const;
+        \endcode
+        the whole sequence is transformed with a single call.
     */
     template <class USG, class IC>
     class InverseCumulativeRsg {
@@ -63,6 +95,16 @@ namespace QuantLib {
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
+        //! \name Substreams
+        /*! These methods are forwarded to the uniform sequence
+            generator and are only available if USG implements them.
+        */
+        //@{
+        void jump() { uniformSequenceGenerator_.jump(); }
+        void skipTo(std::uint_least32_t n) {
+            uniformSequenceGenerator_.skipTo(n);
+        }
+        //@}
       private:
         USG uniformSequenceGenerator_;
         Size dimension_;
@@ -86,9 +128,8 @@ namespace QuantLib {
         typename USG::sample_type sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        detail::inverseCumulativeTransform(ICD_, sample.value.data(),
+                                           x_.value.data(), dimension_, 0);
         return x_;
     }
 
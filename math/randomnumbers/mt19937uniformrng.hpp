@@ -70,6 +70,10 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        /*! advances the state of the generator by 2**128 draws.
+            Repeated calls can be used to obtain non-overlapping
+            substreams, e.g., for parallel simulations. */
+        void jump();
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
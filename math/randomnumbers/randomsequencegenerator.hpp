@@ -84,6 +84,9 @@ namespace QuantLib {
             return sequence_;
         }
         Size dimension() const {return dimensionality_;}
+        /*! advances the underlying generator to a non-overlapping
+            substream; it requires RNG to implement jump() */
+        void jump() { rng_.jump(); }
       private:
         Size dimensionality_;
         RNG rng_;
@@ -34,9 +34,34 @@
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // detects whether a uniform generator can be jumped ahead
+        template <class URNG, class = void>
+        struct has_jump : std::false_type {};
+
+        template <class URNG>
+        struct has_jump<URNG, decltype(std::declval<URNG&>().jump())>
+        : std::true_type {};
+
+        // detects whether a sequence generator can skip samples
+        template <class URSG, class = void>
+        struct has_skip_to : std::false_type {};
+
+        template <class URSG>
+        struct has_skip_to<URSG,
+                           decltype(std::declval<URSG&>().skipTo(
+                                                std::uint_least32_t()))>
+        : std::true_type {};
+
+    }
+
     // random number traits
 
     template <class URNG, class IC>
@@ -48,12 +73,23 @@ namespace QuantLib {
         typedef InverseCumulativeRsg<ursg_type,IC> rsg_type;
         // more traits
         enum { allowsErrorEstimate = 1 };
+        enum { allowsSubstreams = detail::has_jump<URNG>::value };
         // factory
         static rsg_type make_sequence_generator(Size dimension,
                                                 BigNatural seed) {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /* Returns a generator drawing from an independent substream
+           (only available if URNG implements jump()) and moves the given generator to the next one; the index
+           of the first sample is not needed since substreams are
+           obtained by jumping ahead the underlying generator. */
+        static rsg_type make_substream(rsg_type& generator,
+                                       BigNatural) {
+            rsg_type substream(generator);
+            generator.jump();
+            return substream;
+        }
         // data
         static ext::shared_ptr<IC> icInstance;
     };
@@ -85,12 +121,31 @@ namespace QuantLib {
         typedef InverseCumulativeRsg<ursg_type,IC> rsg_type;
         // more traits
         enum { allowsErrorEstimate = 0 };
+        enum { allowsSubstreams = detail::has_skip_to<URSG>::value };
         // factory
         static rsg_type make_sequence_generator(Size dimension,
                                                 BigNatural seed) {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /* Returns a copy of the given generator, which must not have
+           been drawn from yet, skipped (only available if URSG
+           implements skipTo()) to the given sample; this way,
+           consecutive blocks of samples partition the sequence that
+           would be drawn serially. */
+        static rsg_type make_substream(rsg_type& generator,
+                                       BigNatural firstSample) {
+            QL_REQUIRE(firstSample <= std::numeric_limits<
+                                          std::uint_least32_t>::max(),
+                       "cannot skip to sample " << firstSample
+                       << ": at most "
+                       << std::numeric_limits<std::uint_least32_t>::max()
+                       << " samples can be skipped");
+            rsg_type substream(generator);
+            substream.skipTo(
+                static_cast<std::uint_least32_t>(firstSample));
+            return substream;
+        }
         // data
         static ext::shared_ptr<IC> icInstance;
     };
@@ -65,6 +65,21 @@ namespace QuantLib {
         return myIndex + coorOffset1*spacing_[i1]+coorOffset2*spacing_[i2];
     }
 
+    Integer FdmLinearOpLayout::neighbourOffset(Size i, Size coordinate,
+                                               Integer offset) const {
+        if (dim_[i] == 1)
+            return 0;
+
+        Integer coorOffset = Integer(coordinate)+offset;
+        if (coorOffset < 0) {
+            coorOffset=-coorOffset;
+        }
+        else if (Size(coorOffset) >= dim_[i]) {
+            coorOffset = 2*(dim_[i]-1) - coorOffset;
+        }
+        return (coorOffset - Integer(coordinate))*Integer(spacing_[i]);
+    }
+
     // smart but sometimes too slow
     FdmLinearOpIterator FdmLinearOpLayout::iter_neighbourhood(
         const FdmLinearOpIterator& iterator, Size i, Integer offset) const {
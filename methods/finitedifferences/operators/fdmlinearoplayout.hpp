@@ -79,6 +79,33 @@ namespace QuantLib {
         FdmLinearOpIterator iter_neighbourhood(
             const FdmLinearOpIterator& iterator, Size i, Integer offset) const;
 
+        /*! \name Tiling along a direction
+
+            The points sharing all coordinates except the one in
+            direction i form a line. The lines come in blocks of
+            spacing()[i] interleaved lines, each block covering
+            blockSize(i) consecutive indices: point k of line j in
+            block b has the index b*blockSize(i) + k*spacing()[i] + j.
+            Sweeping a block plane by plane therefore accesses memory
+            with unit stride.
+        */
+        //@{
+        Size blockSize(Size i) const {
+            return spacing_[i]*dim_[i];
+        }
+
+        Size blocks(Size i) const {
+            return size_/blockSize(i);
+        }
+
+        /*! index offset from a point with the given coordinate in
+            direction i to its neighbour, reflected at the boundaries
+            in the same way as neighbourhood(). For a single point the
+            offset is zero.
+        */
+        Integer neighbourOffset(Size i, Size coordinate, Integer offset) const;
+        //@}
+
       private:
         Size size_;
         std::vector<Size> dim_, spacing_;
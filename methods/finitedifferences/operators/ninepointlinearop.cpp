@@ -29,14 +29,6 @@ namespace QuantLib {
         Size d0, Size d1,
         const ext::shared_ptr<FdmMesher>& mesher)
     : d0_(d0), d1_(d1),
-      i00_(new Size[mesher->layout()->size()]),
-      i10_(new Size[mesher->layout()->size()]),
-      i20_(new Size[mesher->layout()->size()]),
-      i01_(new Size[mesher->layout()->size()]),
-      i21_(new Size[mesher->layout()->size()]),
-      i02_(new Size[mesher->layout()->size()]),
-      i12_(new Size[mesher->layout()->size()]),
-      i22_(new Size[mesher->layout()->size()]),
       a00_(new Real[mesher->layout()->size()]),
       a10_(new Real[mesher->layout()->size()]),
       a20_(new Real[mesher->layout()->size()]),
@@ -52,33 +44,10 @@ namespace QuantLib {
             && d0_ < mesher->layout()->dim().size()
             && d1_ < mesher->layout()->dim().size(),
             "inconsistent derivative directions");
-
-        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
-
-            i10_[i] = layout->neighbourhood(iter, d1_, -1);
-            i01_[i] = layout->neighbourhood(iter, d0_, -1);
-            i21_[i] = layout->neighbourhood(iter, d0_,  1);
-            i12_[i] = layout->neighbourhood(iter, d1_,  1);
-            i00_[i] = layout->neighbourhood(iter, d0_, -1, d1_, -1);
-            i20_[i] = layout->neighbourhood(iter, d0_,  1, d1_, -1);
-            i02_[i] = layout->neighbourhood(iter, d0_, -1, d1_,  1);
-            i22_[i] = layout->neighbourhood(iter, d0_,  1, d1_,  1);
-        }
     }
 
     NinePointLinearOp::NinePointLinearOp(const NinePointLinearOp& m)
-    : i00_(new Size[m.mesher_->layout()->size()]),
-      i10_(new Size[m.mesher_->layout()->size()]),
-      i20_(new Size[m.mesher_->layout()->size()]),
-      i01_(new Size[m.mesher_->layout()->size()]),
-      i21_(new Size[m.mesher_->layout()->size()]),
-      i02_(new Size[m.mesher_->layout()->size()]),
-      i12_(new Size[m.mesher_->layout()->size()]),
-      i22_(new Size[m.mesher_->layout()->size()]),
+    : d0_(m.d0_), d1_(m.d1_),
       a00_(new Real[m.mesher_->layout()->size()]),
       a10_(new Real[m.mesher_->layout()->size()]),
       a20_(new Real[m.mesher_->layout()->size()]),
@@ -91,14 +60,6 @@ namespace QuantLib {
       mesher_(m.mesher_) {
 
         const Size size = mesher_->layout()->size();
-        std::copy(m.i00_.get(), m.i00_.get()+size, i00_.get());
-        std::copy(m.i10_.get(), m.i10_.get()+size, i10_.get());
-        std::copy(m.i20_.get(), m.i20_.get()+size, i20_.get());
-        std::copy(m.i01_.get(), m.i01_.get()+size, i01_.get());
-        std::copy(m.i21_.get(), m.i21_.get()+size, i21_.get());
-        std::copy(m.i02_.get(), m.i02_.get()+size, i02_.get());
-        std::copy(m.i12_.get(), m.i12_.get()+size, i12_.get());
-        std::copy(m.i22_.get(), m.i22_.get()+size, i22_.get());
         std::copy(m.a00_.get(), m.a00_.get()+size, a00_.get());
         std::copy(m.a10_.get(), m.a10_.get()+size, a10_.get());
         std::copy(m.a20_.get(), m.a20_.get()+size, a20_.get());
@@ -112,49 +73,96 @@ namespace QuantLib {
 
     Array NinePointLinearOp::apply(const Array& u) const {
 
-        const ext::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
-        QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
-                    << u.size() << " vs " << index->size());
+        const ext::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
+        QL_REQUIRE(u.size() == layout->size(),"inconsistent length of r "
+                    << u.size() << " vs " << layout->size());
 
         Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
         const Real *a20(a20_.get()), *a21(a21_.get()), *a22(a22_.get());
-        const Size *i00(i00_.get()), *i01(i01_.get()), *i02(i02_.get());
-        const Size *i10(i10_.get()),                   *i12(i12_.get());
-        const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
-
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
-            retVal[i] =   a00[i]*u[i00[i]]
-                        + a01[i]*u[i01[i]]
-                        + a02[i]*u[i02[i]]
-                        + a10[i]*u[i10[i]]
-                        + a11[i]*u[i]
-                        + a12[i]*u[i12[i]]
-                        + a20[i]*u[i20[i]]
-                        + a21[i]*u[i21[i]]
-                        + a22[i]*u[i22[i]];
+        const Real* uptr = u.begin();
+        Real* yptr = retVal.begin();
+
+        // The grid is swept block by block along the leading one of
+        // the two directions. Within a block the offsets to the
+        // neighbours are constant apart from the first and the last
+        // plane, hence each block splits into three unit-stride runs.
+        const Size da = std::min(d0_, d1_), db = std::max(d0_, d1_);
+        const Size na = layout->dim()[da], nb = layout->dim()[db];
+        const Size sb = layout->spacing()[db];
+        const long sa = (long)layout->spacing()[da];
+        const Size blockSize = layout->blockSize(da);
+        const bool leading0 = (da == d0_);
+        const long nBlocks = long(layout->blocks(da));
+
+        const Integer ma0 = layout->neighbourOffset(da, 0,    -1);
+        const Integer pa0 = layout->neighbourOffset(da, 0,     1);
+        const Integer man = layout->neighbourOffset(da, na-1, -1);
+        const Integer pan = layout->neighbourOffset(da, na-1,  1);
+
+        const auto applyRun = [=](long begin, long end,
+                                  long ma, long pa, long mb, long pb) {
+            const long m0 = leading0 ? ma : mb;
+            const long p0 = leading0 ? pa : pb;
+            const long m1 = leading0 ? mb : ma;
+            const long p1 = leading0 ? pb : pa;
+
+            for (long i=begin; i < end; ++i) {
+                yptr[i] =   a00[i]*uptr[i+m0+m1]
+                          + a01[i]*uptr[i+m0]
+                          + a02[i]*uptr[i+m0+p1]
+                          + a10[i]*uptr[i+m1]
+                          + a11[i]*uptr[i]
+                          + a12[i]*uptr[i+p1]
+                          + a20[i]*uptr[i+p0+m1]
+                          + a21[i]*uptr[i+p0]
+                          + a22[i]*uptr[i+p0+p1];
+            }
+        };
+
+        #pragma omp parallel for
+        for (long block=0; block < nBlocks; ++block) {
+            const long begin = block*long(blockSize);
+            const Size kb = (Size(begin)/sb) % nb;
+            const long mb = layout->neighbourOffset(db, kb, -1);
+            const long pb = layout->neighbourOffset(db, kb,  1);
+
+            applyRun(begin, begin+sa, ma0, pa0, mb, pb);
+            if (na > 2)
+                applyRun(begin+sa, begin+long(na-1)*sa, -sa, sa, mb, pb);
+            if (na > 1)
+                applyRun(begin+long(na-1)*sa, begin+long(na)*sa,
+                         man, pan, mb, pb);
         }
+
         return retVal;
     }
 
     SparseMatrix NinePointLinearOp::toMatrix() const {
-        const ext::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
-        const Size n = index->size();
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size n = layout->size();
 
         SparseMatrix retVal(n, n, 9*n);
-        for (Size i=0; i < index->size(); ++i) {
-            retVal(i, i00_[i]) += a00_[i];
-            retVal(i, i01_[i]) += a01_[i];
-            retVal(i, i02_[i]) += a02_[i];
-            retVal(i, i10_[i]) += a10_[i];
+        for (FdmLinearOpIterator iter = layout->begin();
+             iter != layout->end(); ++iter) {
+            const Size i = iter.index();
+            const std::vector<Size>& c = iter.coordinates();
+            const Integer m0 = layout->neighbourOffset(d0_, c[d0_], -1);
+            const Integer p0 = layout->neighbourOffset(d0_, c[d0_],  1);
+            const Integer m1 = layout->neighbourOffset(d1_, c[d1_], -1);
+            const Integer p1 = layout->neighbourOffset(d1_, c[d1_],  1);
+
+            retVal(i, i+m0+m1) += a00_[i];
+            retVal(i, i+m0   ) += a01_[i];
+            retVal(i, i+m0+p1) += a02_[i];
+            retVal(i, i   +m1) += a10_[i];
             retVal(i, i      ) += a11_[i];
-            retVal(i, i12_[i]) += a12_[i];
-            retVal(i, i20_[i]) += a20_[i];
-            retVal(i, i21_[i]) += a21_[i];
-            retVal(i, i22_[i]) += a22_[i];
+            retVal(i, i   +p1) += a12_[i];
+            retVal(i, i+p0+m1) += a20_[i];
+            retVal(i, i+p0   ) += a21_[i];
+            retVal(i, i+p0+p1) += a22_[i];
         }
 
         return retVal;
@@ -183,9 +191,6 @@ namespace QuantLib {
         std::swap(d0_, m.d0_);
         std::swap(d1_, m.d1_);
 
-        i00_.swap(m.i00_); i10_.swap(m.i10_); i20_.swap(m.i20_);
-        i01_.swap(m.i01_); i21_.swap(m.i21_); i02_.swap(m.i02_);
-        i12_.swap(m.i12_); i22_.swap(m.i22_);
         a00_.swap(m.a00_); a10_.swap(m.a10_); a20_.swap(m.a20_);
         a01_.swap(m.a01_); a21_.swap(m.a21_); a02_.swap(m.a02_);
         a12_.swap(m.a12_); a22_.swap(m.a22_); a11_.swap(m.a11_);
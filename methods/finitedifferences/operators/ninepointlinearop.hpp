@@ -54,9 +54,8 @@ namespace QuantLib {
         NinePointLinearOp() = default;
 
         Size d0_, d1_;
-        std::unique_ptr<Size[]> i00_, i10_, i20_;
-        std::unique_ptr<Size[]> i01_, i21_;
-        std::unique_ptr<Size[]> i02_, i12_, i22_;
+        // coefficients in the grid order of the layout; the neighbours
+        // follow from the layout's tiling along d0_ and d1_
         std::unique_ptr<Real[]> a00_, a10_, a20_;
         std::unique_ptr<Real[]> a01_, a11_, a21_;
         std::unique_ptr<Real[]> a02_, a12_, a22_;
@@ -27,54 +27,29 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // number of interleaved lines swept together by solve_splitting
+        const Size tileSize = 64;
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const ext::shared_ptr<FdmMesher>& mesher)
     : direction_(direction),
-      i0_       (new Size[mesher->layout()->size()]),
-      i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
-      mesher_(mesher) {
-
-        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        std::vector<Size> newDim(layout->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
-
-            i0_[i] = layout->neighbourhood(iter, direction, -1);
-            i2_[i] = layout->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
-        }
-    }
+      mesher_(mesher) {}
 
     TripleBandLinearOp::TripleBandLinearOp(const TripleBandLinearOp& m)
     : direction_(m.direction_),
-      i0_   (new Size[m.mesher_->layout()->size()]),
-      i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
       mesher_(m.mesher_) {
         const Size len = m.mesher_->layout()->size();
-        std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
-        std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
-        std::copy(m.reverseIndex_.get(), m.reverseIndex_.get()+len,
-                  reverseIndex_.get());
         std::copy(m.lower_.get(), m.lower_.get() + len, lower_.get());
         std::copy(m.diag_.get(),  m.diag_.get() + len,  diag_.get());
         std::copy(m.upper_.get(), m.upper_.get() + len, upper_.get());
@@ -84,8 +59,6 @@ namespace QuantLib {
         std::swap(mesher_, m.mesher_);
         std::swap(direction_, m.direction_);
 
-        i0_.swap(m.i0_); i2_.swap(m.i2_);
-        reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
     }
 
@@ -226,34 +199,74 @@ namespace QuantLib {
     }
 
     Array TripleBandLinearOp::apply(const Array& r) const {
-        const ext::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
 
-        QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(r.size() == layout->size(), "inconsistent length of r");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
-        const Size* i0ptr = i0_.get();
-        const Size* i2ptr = i2_.get();
+        const Real* rptr = r.begin();
+
+        const Size n = layout->dim()[direction_];
+        const long s = (long)layout->spacing()[direction_];
 
         array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        Real* yptr = retVal.begin();
+
+        if (s == 1) {
+            // the lines are contiguous, one line per iteration
+            const long nLines = long(layout->blocks(direction_));
+            const Integer m0 = layout->neighbourOffset(direction_, 0,   -1);
+            const Integer p0 = layout->neighbourOffset(direction_, 0,    1);
+            const Integer mn = layout->neighbourOffset(direction_, n-1, -1);
+            const Integer pn = layout->neighbourOffset(direction_, n-1,  1);
+
+            #pragma omp parallel for if(nLines > 1)
+            for (long line=0; line < nLines; ++line) {
+                const long begin = line*long(n), end = begin+long(n)-1;
+
+                yptr[begin] = rptr[begin+m0]*lptr[begin]
+                    + rptr[begin]*dptr[begin] + rptr[begin+p0]*uptr[begin];
+                for (long i=begin+1; i < end; ++i)
+                    yptr[i] = rptr[i-1]*lptr[i]+rptr[i]*dptr[i]+rptr[i+1]*uptr[i];
+                if (end > begin)
+                    yptr[end] = rptr[end+mn]*lptr[end]
+                        + rptr[end]*dptr[end] + rptr[end+pn]*uptr[end];
+            }
+        }
+        else {
+            // one plane of s interleaved lines per iteration
+            const long nPlanes = long(layout->size())/s;
+
+            #pragma omp parallel for
+            for (long plane=0; plane < nPlanes; ++plane) {
+                const Size k = Size(plane) % n;
+                const long m = layout->neighbourOffset(direction_, k, -1);
+                const long p = layout->neighbourOffset(direction_, k,  1);
+
+                for (long i=plane*s; i < (plane+1)*s; ++i)
+                    yptr[i] = rptr[i+m]*lptr[i]+rptr[i]*dptr[i]+rptr[i+p]*uptr[i];
+            }
         }
 
         return retVal;
     }
 
     SparseMatrix TripleBandLinearOp::toMatrix() const {
-        const ext::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
-        const Size n = index->size();
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size n = layout->size();
 
         SparseMatrix retVal(n, n, 3*n);
-        for (Size i=0; i < n; ++i) {
-            retVal(i, i0_[i]) += lower_[i];
-            retVal(i, i     ) += diag_[i];
-            retVal(i, i2_[i]) += upper_[i];
+        for (FdmLinearOpIterator iter = layout->begin();
+             iter != layout->end(); ++iter) {
+            const Size i = iter.index();
+            const Size k = iter.coordinates()[direction_];
+            retVal(i, i + layout->neighbourOffset(direction_, k, -1))
+                += lower_[i];
+            retVal(i, i) += diag_[i];
+            retVal(i, i + layout->neighbourOffset(direction_, k,  1))
+                += upper_[i];
         }
 
         return retVal;
@@ -280,30 +293,92 @@ namespace QuantLib {
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
-
+        const Real* rptr = r.begin();
+        Real* xptr = retVal.begin();
+        Real* tptr = tmp.begin();
+
+        // The boundary rows have no entries outside of their line, hence
+        // the system decouples into independent tridiagonal systems, one
+        // per line along direction_. Every line runs through the same
+        // operations as a single sweep over all of them, so the result
+        // doesn't depend on the number of threads or on the tiling.
+        //
         // Thomson algorithm to solve a tridiagonal system.
         // Example code taken from Tridiagonalopertor and
         // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        const Size n = layout->dim()[direction_];
+        const Size s = layout->spacing()[direction_];
+        const Size blockSize = layout->blockSize(direction_);
+        const long nBlocks = long(layout->blocks(direction_));
+
+        bool singular = false;
+        if (s == 1) {
+            // contiguous lines, one line per iteration
+            #pragma omp parallel for if(nBlocks > 1) reduction(||:singular)
+            for (long line=0; line < nBlocks; ++line) {
+                const Size begin = Size(line)*n;
+
+                Real bet = a*dptr[begin]+b;
+                singular = singular || (bet == 0.0);
+                bet = 1.0/bet;
+                xptr[begin] = rptr[begin]*bet;
+
+                for (Size i=begin+1; i < begin+n; ++i) {
+                    tptr[i] = a*uptr[i-1]*bet;
+
+                    bet = b+a*(dptr[i]-tptr[i]*lptr[i]);
+                    singular = singular || (bet == 0.0);
+                    bet = 1.0/bet;
+
+                    xptr[i] = (rptr[i]-a*lptr[i]*xptr[i-1])*bet;
+                }
+                for (Size i=begin+n-1; i > begin; --i)
+                    xptr[i-1] -= tptr[i]*xptr[i];
+            }
+        }
+        else {
+            // interleaved lines, swept plane by plane in tiles of
+            // tileSize lines so that the inner loops are unit-stride
+            const long nTiles = long((s + tileSize - 1)/tileSize);
+
+            #pragma omp parallel for reduction(||:singular)
+            for (long w=0; w < nBlocks*nTiles; ++w) {
+                const Size offset = Size(w%nTiles)*tileSize;
+                const Size first = Size(w/nTiles)*blockSize + offset;
+                const Size width = std::min(tileSize, s - offset);
+                Real bet[tileSize];
+                bool zeroPivot = false;
+
+                for (Size j=0; j < width; ++j) {
+                    const Size i = first + j;
+                    bet[j] = a*dptr[i]+b;
+                    zeroPivot |= (bet[j] == 0.0);
+                    bet[j] = 1.0/bet[j];
+                    xptr[i] = rptr[i]*bet[j];
+                }
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+                for (Size k=1; k < n; ++k) {
+                    const Size plane = first + k*s;
+                    for (Size j=0; j < width; ++j) {
+                        const Size i = plane + j;
+                        tptr[i] = a*uptr[i-s]*bet[j];
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                        bet[j] = b+a*(dptr[i]-tptr[i]*lptr[i]);
+                        zeroPivot |= (bet[j] == 0.0);
+                        bet[j] = 1.0/bet[j];
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                        xptr[i] = (rptr[i]-a*lptr[i]*xptr[i-s])*bet[j];
+                    }
+                }
+                for (Size k=n-1; k > 0; --k) {
+                    const Size plane = first + k*s;
+                    for (Size j=0; j < width; ++j)
+                        xptr[plane+j-s] -= tptr[plane+j]*xptr[plane+j];
+                }
+                singular = singular || zeroPivot;
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        QL_ENSURE(!singular, "division by zero");
 
         return retVal;
     }
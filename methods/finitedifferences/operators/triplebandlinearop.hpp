@@ -66,8 +66,8 @@ namespace QuantLib {
         TripleBandLinearOp() = default;
 
         Size direction_;
-        std::unique_ptr<Size[]> i0_, i2_;
-        std::unique_ptr<Size[]> reverseIndex_;
+        // coefficients in the grid order of the layout; the neighbours
+        // follow from the layout's tiling along direction_
         std::unique_ptr<Real[]> lower_, diag_, upper_;
 
         ext::shared_ptr<FdmMesher> mesher_;
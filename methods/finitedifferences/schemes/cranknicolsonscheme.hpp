@@ -50,7 +50,9 @@ namespace QuantLib {
             const bc_set& bcSet = bc_set(),
             Real relTol = 1e-8,
             ImplicitEulerScheme::SolverType solverType
-                = ImplicitEulerScheme::BiCGstab);
+                = ImplicitEulerScheme::BiCGstab,
+            ImplicitEulerScheme::PreconditionerType preconditionerType
+                = ImplicitEulerScheme::Splitting);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
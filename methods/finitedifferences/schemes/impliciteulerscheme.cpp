@@ -21,18 +21,77 @@
 
 #include <ql/functional.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/incompletelupreconditioner.hpp>
+#include <ql/math/matrixutilities/jacobipreconditioner.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <utility>
 
 namespace QuantLib {
 
+    namespace {
+
+        // relative change of the operator, measured on a test vector,
+        // up to which a sparse preconditioner is reused
+        const Real preconditionerTolerance = 1.0e-2;
+
+        // I + s*L, with the diagonal added to the pattern if needed
+        CompressedRowMatrix shiftedIdentity(const CompressedRowMatrix& L,
+                                            Real s) {
+            const Size n = L.rows();
+            const std::vector<Size>& rowStart = L.rowStart();
+            const std::vector<Size>& columnIndex = L.columnIndex();
+            const std::vector<Real>& values = L.values();
+
+            std::vector<Size> start(n+1, 0), columns;
+            std::vector<Real> v;
+            columns.reserve(L.nonZeros()+n);
+            v.reserve(L.nonZeros()+n);
+
+            for (Size i=0; i < n; ++i) {
+                bool diagonal = false;
+                for (Size k=rowStart[i]; k < rowStart[i+1]; ++k) {
+                    const Size j = columnIndex[k];
+                    if (!diagonal && j >= i) {
+                        diagonal = true;
+                        if (j > i) {
+                            columns.push_back(i);
+                            v.push_back(1.0);
+                        }
+                    }
+                    columns.push_back(j);
+                    v.push_back(s*values[k] + ((j == i) ? 1.0 : 0.0));
+                }
+                if (!diagonal) {
+                    columns.push_back(i);
+                    v.push_back(1.0);
+                }
+                start[i+1] = columns.size();
+            }
+
+            return {n, n, std::move(start), std::move(columns), std::move(v)};
+        }
+
+    }
+
+    struct ImplicitEulerScheme::PreconditionerCache {
+        Real scale = Null<Real>();
+        // fixed test vector and its image under the operator the
+        // preconditioner was built from
+        Array probe, image;
+        ext::function<Array(const Array&)> apply;
+    };
+
     ImplicitEulerScheme::ImplicitEulerScheme(ext::shared_ptr<FdmLinearOpComposite> map,
                                              const bc_set& bcSet,
                                              Real relTol,
-                                             SolverType solverType)
+                                             SolverType solverType,
+                                             PreconditionerType preconditionerType)
     : dt_(Null<Real>()), iterations_(ext::make_shared<Size>(0U)), relTol_(relTol),
-      map_(std::move(map)), bcSet_(bcSet), solverType_(solverType) {}
+      map_(std::move(map)), bcSet_(bcSet), solverType_(solverType),
+      preconditionerType_(preconditionerType),
+      preconditionerCache_(ext::make_shared<PreconditionerCache>()) {}
 
     Array ImplicitEulerScheme::apply(const Array& r, Real theta) const {
         return r - (theta*dt_)*map_->apply(r);
@@ -53,7 +112,11 @@ namespace QuantLib {
             a = map_->solve_splitting(0, a, -theta*dt_);
         }
         else {
-            auto preconditioner = [&](const Array& _a){ return map_->preconditioner(_a, -theta*dt_); };
+            ext::function<Array(const Array&)> preconditioner;
+            if (preconditionerType_ == Splitting)
+                preconditioner = [&](const Array& _a){ return map_->preconditioner(_a, -theta*dt_); };
+            else
+                preconditioner = sparsePreconditioner(-theta*dt_);
             auto applyF = [&](const Array& _a){ return apply(_a, theta); };
 
             if (solverType_ == BiCGstab) {
@@ -79,6 +142,48 @@ namespace QuantLib {
         bcSet_.applyAfterSolving(a);
     }
 
+    ext::function<Array(const Array&)>
+    ImplicitEulerScheme::sparsePreconditioner(Real s) const {
+        PreconditionerCache& cache = *preconditionerCache_;
+
+        // a single operator application tells whether the operator
+        // has moved away from the one the preconditioner was built for
+        if (cache.apply && cache.scale == s) {
+            const Array image = map_->apply(cache.probe);
+            if (Norm2(image - cache.image)
+                    <= preconditionerTolerance*Norm2(cache.image))
+                return cache.apply;
+        }
+
+        const std::vector<SparseMatrix> decomposition =
+            map_->toMatrixDecomp();
+        CompressedRowMatrix L(decomposition.front());
+        for (Size i=1; i < decomposition.size(); ++i)
+            L = L + CompressedRowMatrix(decomposition[i]);
+        const CompressedRowMatrix m = shiftedIdentity(L, s);
+
+        if (preconditionerType_ == ILU) {
+            const auto p = ext::make_shared<IncompleteLUPreconditioner>(m);
+            cache.apply = [p](const Array& x) { return p->apply(x); };
+        }
+        else if (preconditionerType_ == Jacobi) {
+            const auto p = ext::make_shared<JacobiPreconditioner>(m);
+            cache.apply = [p](const Array& x) { return p->apply(x); };
+        }
+        else
+            QL_FAIL("unknown/illegal preconditioner type");
+
+        if (cache.probe.size() != m.rows()) {
+            cache.probe = Array(m.rows());
+            for (Size i=0; i < m.rows(); ++i)
+                cache.probe[i] = 1.0 + 0.5*std::sin(Real(i));
+        }
+        cache.image = map_->apply(cache.probe);
+        cache.scale = s;
+
+        return cache.apply;
+    }
+
     void ImplicitEulerScheme::setStep(Time dt) {
         dt_=dt;
     }
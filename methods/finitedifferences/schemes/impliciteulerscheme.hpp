@@ -26,6 +26,7 @@
 #ifndef quantlib_implicit_euler_scheme_hpp
 #define quantlib_implicit_euler_scheme_hpp
 
+#include <ql/functional.hpp>
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/schemes/boundaryconditionschemehelper.hpp>
@@ -36,6 +37,19 @@ namespace QuantLib {
       public:
         enum SolverType { BiCGstab, GMRES };
 
+        /*! Splitting uses FdmLinearOpComposite::preconditioner().
+            ILU and Jacobi assemble \f$ I - \theta\,dt\,L \f$ in
+            compressed row storage from
+            FdmLinearOpComposite::toMatrixDecomp() and build an
+            incomplete LU or diagonal preconditioner from it. The
+            preconditioner is reused as long as the step size stays the
+            same and the operator doesn't change by more than 1% on a
+            test vector, i.e. it is built once for time-homogeneous
+            operators and refreshed only occasionally for
+            time-dependent ones.
+        */
+        enum PreconditionerType { Splitting, ILU, Jacobi };
+
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
         typedef traits::operator_type operator_type;
@@ -47,7 +61,9 @@ namespace QuantLib {
         explicit ImplicitEulerScheme(ext::shared_ptr<FdmLinearOpComposite> map,
                                      const bc_set& bcSet = bc_set(),
                                      Real relTol = 1e-8,
-                                     SolverType solverType = BiCGstab);
+                                     SolverType solverType = BiCGstab,
+                                     PreconditionerType preconditionerType
+                                         = Splitting);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -58,6 +74,7 @@ namespace QuantLib {
         void step(array_type& a, Time t, Real theta);
 
         Array apply(const Array& r, Real theta) const;
+        ext::function<Array(const Array&)> sparsePreconditioner(Real s) const;
           
         Time dt_;
         ext::shared_ptr<Size> iterations_;
@@ -66,6 +83,10 @@ namespace QuantLib {
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
         const SolverType solverType_;
+        const PreconditionerType preconditionerType_;
+
+        struct PreconditionerCache;
+        ext::shared_ptr<PreconditionerCache> preconditionerCache_;
     };
 }
 
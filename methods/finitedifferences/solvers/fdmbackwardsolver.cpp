@@ -24,6 +24,7 @@
 
 #include <ql/mathconstants.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
@@ -77,6 +78,204 @@ namespace QuantLib {
 
     FdmSchemeDesc FdmSchemeDesc::TrBDF2() { return {FdmSchemeDesc::TrBDF2Type, 2 - M_SQRT2, 1e-8}; }
 
+    namespace {
+        /* shares the operator set-up of a time step between all
+           vectors of a batch, the schemes call setTime before
+           every operator application. */
+        class FdmTimeCachedOp : public FdmLinearOpComposite {
+          public:
+            explicit FdmTimeCachedOp(ext::shared_ptr<FdmLinearOpComposite> op)
+            : op_(std::move(op)), t1_(Null<Real>()), t2_(Null<Real>()) {}
+
+            Size size() const override { return op_->size(); }
+            void setTime(Time t1, Time t2) override {
+                if (t1 != t1_ || t2 != t2_) {
+                    op_->setTime(t1, t2);
+                    t1_ = t1;
+                    t2_ = t2;
+                }
+            }
+
+            Array apply(const Array& r) const override {
+                return op_->apply(r);
+            }
+            Array apply_mixed(const Array& r) const override {
+                return op_->apply_mixed(r);
+            }
+            Array apply_direction(Size direction,
+                                  const Array& r) const override {
+                return op_->apply_direction(direction, r);
+            }
+            Array solve_splitting(Size direction,
+                                  const Array& r, Real s) const override {
+                return op_->solve_splitting(direction, r, s);
+            }
+            Array preconditioner(const Array& r, Real s) const override {
+                return op_->preconditioner(r, s);
+            }
+
+            std::vector<SparseMatrix> toMatrixDecomp() const override {
+                return op_->toMatrixDecomp();
+            }
+            SparseMatrix toMatrix() const override {
+                return op_->toMatrix();
+            }
+
+          private:
+            const ext::shared_ptr<FdmLinearOpComposite> op_;
+            Time t1_, t2_;
+        };
+
+        typedef std::vector<FdmBackwardSolver::array_type> BatchArray;
+
+        class FdmBatchStepCondition : public StepCondition<BatchArray> {
+          public:
+            FdmBatchStepCondition(
+                ext::shared_ptr<FdmStepConditionComposite> condition,
+                const std::vector<ext::shared_ptr<FdmStepConditionComposite> >&
+                    conditions)
+            : condition_(std::move(condition)), conditions_(conditions) {}
+
+            void applyTo(BatchArray& a, Time t) const override {
+                for (Size i=0; i < a.size(); ++i) {
+                    condition_->applyTo(a[i], t);
+                    if (conditions_[i] != nullptr)
+                        conditions_[i]->applyTo(a[i], t);
+                }
+            }
+
+          private:
+            const ext::shared_ptr<FdmStepConditionComposite> condition_;
+            const std::vector<ext::shared_ptr<FdmStepConditionComposite> >&
+                conditions_;
+        };
+
+        // steps every vector of a batch with the same evolver
+        template <class Evolver>
+        class FdmBatchEvolver {
+          public:
+            struct traits {
+                typedef FdmLinearOp operator_type;
+                typedef BatchArray array_type;
+                typedef FdmBoundaryConditionSet bc_set;
+                typedef StepCondition<BatchArray> condition_type;
+            };
+
+            explicit FdmBatchEvolver(Evolver evolver)
+            : evolver_(std::move(evolver)) {}
+
+            void step(BatchArray& a, Time t) {
+                for (auto& v : a)
+                    evolver_.step(v, t);
+            }
+            void setStep(Time dt) { evolver_.setStep(dt); }
+
+          private:
+            Evolver evolver_;
+        };
+
+        template <class Evolver, class ArrayType>
+        struct FdmEvolverFor {
+            typedef Evolver type;
+        };
+
+        template <class Evolver>
+        struct FdmEvolverFor<Evolver, BatchArray> {
+            typedef FdmBatchEvolver<Evolver> type;
+        };
+
+        template <class Evolver, class ArrayType>
+        void rollbackWith(const Evolver& evolver,
+                          const std::vector<Time>& stoppingTimes,
+                          ArrayType& rhs, Time from, Time to, Size steps,
+                          const StepCondition<ArrayType>& condition) {
+            typedef typename FdmEvolverFor<Evolver, ArrayType>::type
+                evolver_type;
+
+            FiniteDifferenceModel<evolver_type> model(
+                evolver_type(evolver), stoppingTimes);
+            model.rollback(rhs, from, to, steps, condition);
+        }
+
+        template <class ArrayType>
+        void rollbackImpl(const ext::shared_ptr<FdmLinearOpComposite>& map,
+                          const FdmBoundaryConditionSet& bcSet,
+                          const FdmSchemeDesc& schemeDesc,
+                          const std::vector<Time>& stoppingTimes,
+                          const StepCondition<ArrayType>& condition,
+                          ArrayType& rhs,
+                          Time from, Time to,
+                          Size steps, Size dampingSteps) {
+
+            const Time deltaT = from - to;
+            const Size allSteps = steps + dampingSteps;
+            const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
+
+            if ((dampingSteps != 0U)
+                && schemeDesc.type != FdmSchemeDesc::ImplicitEulerType) {
+                rollbackWith(ImplicitEulerScheme(map, bcSet), stoppingTimes,
+                             rhs, from, dampingTo, dampingSteps, condition);
+            }
+
+            switch (schemeDesc.type) {
+              case FdmSchemeDesc::HundsdorferType:
+                rollbackWith(HundsdorferScheme(schemeDesc.theta, schemeDesc.mu,
+                                               map, bcSet),
+                             stoppingTimes, rhs, dampingTo, to, steps, condition);
+                break;
+              case FdmSchemeDesc::DouglasType:
+                rollbackWith(DouglasScheme(schemeDesc.theta, map, bcSet),
+                             stoppingTimes, rhs, dampingTo, to, steps, condition);
+                break;
+              case FdmSchemeDesc::CrankNicolsonType:
+                rollbackWith(CrankNicolsonScheme(schemeDesc.theta, map, bcSet),
+                             stoppingTimes, rhs, dampingTo, to, steps, condition);
+                break;
+              case FdmSchemeDesc::CraigSneydType:
+                rollbackWith(CraigSneydScheme(schemeDesc.theta, schemeDesc.mu,
+                                              map, bcSet),
+                             stoppingTimes, rhs, dampingTo, to, steps, condition);
+                break;
+              case FdmSchemeDesc::ModifiedCraigSneydType:
+                rollbackWith(ModifiedCraigSneydScheme(schemeDesc.theta,
+                                                      schemeDesc.mu, map, bcSet),
+                             stoppingTimes, rhs, dampingTo, to, steps, condition);
+                break;
+              case FdmSchemeDesc::ImplicitEulerType:
+                rollbackWith(ImplicitEulerScheme(map, bcSet),
+                             stoppingTimes, rhs, from, to, allSteps, condition);
+                break;
+              case FdmSchemeDesc::ExplicitEulerType:
+                rollbackWith(ExplicitEulerScheme(map, bcSet),
+                             stoppingTimes, rhs, dampingTo, to, steps, condition);
+                break;
+              case FdmSchemeDesc::MethodOfLinesType:
+                rollbackWith(MethodOfLinesScheme(schemeDesc.theta, schemeDesc.mu,
+                                                 map, bcSet),
+                             stoppingTimes, rhs, dampingTo, to, steps, condition);
+                break;
+              case FdmSchemeDesc::TrBDF2Type:
+                {
+                    const FdmSchemeDesc trDesc
+                        = FdmSchemeDesc::CraigSneyd();
+
+                    const ext::shared_ptr<CraigSneydScheme> hsEvolver(
+                        ext::make_shared<CraigSneydScheme>(
+                            trDesc.theta, trDesc.mu, map, bcSet));
+
+                    rollbackWith(TrBDF2Scheme<CraigSneydScheme>(
+                                     schemeDesc.theta, map, hsEvolver,
+                                     bcSet, schemeDesc.mu),
+                                 stoppingTimes, rhs, dampingTo, to, steps,
+                                 condition);
+                }
+                break;
+              default:
+                QL_FAIL("Unknown scheme type");
+            }
+        }
+    }
+
     FdmBackwardSolver::FdmBackwardSolver(
         ext::shared_ptr<FdmLinearOpComposite> map,
         FdmBoundaryConditionSet bcSet,
@@ -92,109 +291,33 @@ namespace QuantLib {
     void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
                                      Time from, Time to,
                                      Size steps, Size dampingSteps) {
+        rollbackImpl(map_, bcSet_, schemeDesc_,
+                     condition_->stoppingTimes(), *condition_,
+                     rhs, from, to, steps, dampingSteps);
+    }
 
-        const Time deltaT = from - to;
-        const Size allSteps = steps + dampingSteps;
-        const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
+    void FdmBackwardSolver::rollback(
+        std::vector<FdmBackwardSolver::array_type>& rhs,
+        const std::vector<ext::shared_ptr<FdmStepConditionComposite> >&
+            conditions,
+        Time from, Time to, Size steps, Size dampingSteps) {
 
-        if ((dampingSteps != 0U) && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
-            FiniteDifferenceModel<ImplicitEulerScheme> 
-                    dampingModel(implicitEvolver, condition_->stoppingTimes());
-            dampingModel.rollback(rhs, from, dampingTo, 
-                                  dampingSteps, *condition_);
-        }
+        QL_REQUIRE(rhs.size() == conditions.size(),
+                   "number of value vectors (" << rhs.size()
+                   << ") and of step conditions (" << conditions.size()
+                   << ") differ");
 
-        switch (schemeDesc_.type) {
-          case FdmSchemeDesc::HundsdorferType:
-            {
-                HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu, 
-                                            map_, bcSet_);
-                FiniteDifferenceModel<HundsdorferScheme> 
-                               hsModel(hsEvolver, condition_->stoppingTimes());
-                hsModel.rollback(rhs, dampingTo, to, steps, *condition_);
-            }
-            break;
-          case FdmSchemeDesc::DouglasType:
-            {
-                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
-                FiniteDifferenceModel<DouglasScheme> 
-                               dsModel(dsEvolver, condition_->stoppingTimes());
-                dsModel.rollback(rhs, dampingTo, to, steps, *condition_);
-            }
-            break;
-          case FdmSchemeDesc::CrankNicolsonType:
-            {
-              CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map_, bcSet_);
-              FiniteDifferenceModel<CrankNicolsonScheme>
-                             cnModel(cnEvolver, condition_->stoppingTimes());
-              cnModel.rollback(rhs, dampingTo, to, steps, *condition_);
+        std::vector<Time> stoppingTimes = condition_->stoppingTimes();
+        for (const auto& condition : conditions)
+            if (condition != nullptr)
+                stoppingTimes.insert(stoppingTimes.end(),
+                                     condition->stoppingTimes().begin(),
+                                     condition->stoppingTimes().end());
 
-            }
-            break;
-          case FdmSchemeDesc::CraigSneydType:
-            {
-                CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu, 
-                                           map_, bcSet_);
-                FiniteDifferenceModel<CraigSneydScheme> 
-                               csModel(csEvolver, condition_->stoppingTimes());
-                csModel.rollback(rhs, dampingTo, to, steps, *condition_);
-            }
-            break;
-          case FdmSchemeDesc::ModifiedCraigSneydType:
-            {
-                ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta, 
-                                                   schemeDesc_.mu,
-                                                   map_, bcSet_);
-                FiniteDifferenceModel<ModifiedCraigSneydScheme> 
-                              mcsModel(csEvolver, condition_->stoppingTimes());
-                mcsModel.rollback(rhs, dampingTo, to, steps, *condition_);
-            }
-            break;
-          case FdmSchemeDesc::ImplicitEulerType:
-            {
-                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ImplicitEulerScheme> 
-                   implicitModel(implicitEvolver, condition_->stoppingTimes());
-                implicitModel.rollback(rhs, from, to, allSteps, *condition_);
-            }
-            break;
-          case FdmSchemeDesc::ExplicitEulerType:
-            {
-                ExplicitEulerScheme explicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ExplicitEulerScheme> 
-                   explicitModel(explicitEvolver, condition_->stoppingTimes());
-                explicitModel.rollback(rhs, dampingTo, to, steps, *condition_);
-            }
-            break;
-          case FdmSchemeDesc::MethodOfLinesType:
-            {
-                MethodOfLinesScheme methodOfLines(
-                    schemeDesc_.theta, schemeDesc_.mu, map_, bcSet_);
-                FiniteDifferenceModel<MethodOfLinesScheme>
-                   molModel(methodOfLines, condition_->stoppingTimes());
-                molModel.rollback(rhs, dampingTo, to, steps, *condition_);
-            }
-            break;
-          case FdmSchemeDesc::TrBDF2Type:
-            {
-                const FdmSchemeDesc trDesc
-                    = FdmSchemeDesc::CraigSneyd();
-
-                const ext::shared_ptr<CraigSneydScheme> hsEvolver(
-                    ext::make_shared<CraigSneydScheme>(
-                        trDesc.theta, trDesc.mu, map_, bcSet_));
-
-                TrBDF2Scheme<CraigSneydScheme> trBDF2(
-                    schemeDesc_.theta, map_, hsEvolver, bcSet_,schemeDesc_.mu);
-
-                FiniteDifferenceModel<TrBDF2Scheme<CraigSneydScheme> >
-                   trBDF2Model(trBDF2, condition_->stoppingTimes());
-                trBDF2Model.rollback(rhs, dampingTo, to, steps, *condition_);
-            }
-            break;
-          default:
-            QL_FAIL("Unknown scheme type");
-        }
+        rollbackImpl(ext::shared_ptr<FdmLinearOpComposite>(
+                         ext::make_shared<FdmTimeCachedOp>(map_)),
+                     bcSet_, schemeDesc_, stoppingTimes,
+                     FdmBatchStepCondition(condition_, conditions),
+                     rhs, from, to, steps, dampingSteps);
     }
 }
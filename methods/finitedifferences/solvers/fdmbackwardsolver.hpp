@@ -26,6 +26,7 @@
 #define quantlib_fdm_backward_solver_hpp
 
 #include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -71,6 +72,17 @@ namespace QuantLib {
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        /*! rolls back several value vectors on the same grid in one sweep.
+            The operator is set up once per time step and shared by all
+            vectors. Vector i is subject to the condition given in the
+            constructor followed by conditions[i], which can be null.
+        */
+        void rollback(std::vector<array_type>& a,
+                      const std::vector<ext::shared_ptr<
+                          FdmStepConditionComposite> >& conditions,
+                      Time from, Time to,
+                      Size steps, Size dampingSteps);
+
       protected:
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
@@ -8,12 +8,16 @@
 #include <ql/methods/montecarlo/longstaffschwartzpathpricer.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/montecarlobatchmodel.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <ql/methods/montecarlo/multipathgenerator.hpp>
 #include <ql/methods/montecarlo/nodedata.hpp>
 #include <ql/methods/montecarlo/parametricexercise.hpp>
 #include <ql/methods/montecarlo/path.hpp>
+#include <ql/methods/montecarlo/pathbatch.hpp>
+#include <ql/methods/montecarlo/pathbatchgenerator.hpp>
+#include <ql/methods/montecarlo/pathbatchpricer.hpp>
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
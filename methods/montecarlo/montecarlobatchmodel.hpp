@@ -0,0 +1,119 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file montecarlobatchmodel.hpp
+    \brief Monte Carlo model working on batches of paths
+*/
+
+#ifndef quantlib_montecarlo_batch_model_hpp
+#define quantlib_montecarlo_batch_model_hpp
+
+#include <ql/math/statistics/statistics.hpp>
+#include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/pathbatchgenerator.hpp>
+#include <ql/methods/montecarlo/pathbatchpricer.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Monte Carlo model working on batches of paths
+    /*! This is the counterpart of MonteCarloModel for path
+        generators and pricers working on whole batches of paths at
+        once.  Antithetic variates are supported; control variates
+        are not.
+
+        \note samples are drawn by whole batches.  When the number of
+              requested samples is not a multiple of the batch size,
+              the paths of the last batch that are not needed are
+              discarded and the underlying sequence generator is not
+              rewound.
+
+        \ingroup mcarlo
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MonteCarloBatchModel {
+      public:
+        typedef RNG rng_traits;
+        typedef PathBatchGenerator<typename RNG::rsg_type>
+            path_generator_type;
+        typedef PathBatchPricer path_pricer_type;
+        typedef PathBatch sample_type;
+        typedef S stats_type;
+        MonteCarloBatchModel(ext::shared_ptr<path_generator_type> pathGenerator,
+                             ext::shared_ptr<path_pricer_type> pathPricer,
+                             stats_type sampleAccumulator,
+                             bool antitheticVariate);
+        void addSamples(Size samples);
+        const stats_type& sampleAccumulator() const;
+      private:
+        ext::shared_ptr<path_generator_type> pathGenerator_;
+        ext::shared_ptr<path_pricer_type> pathPricer_;
+        stats_type sampleAccumulator_;
+        bool isAntitheticVariate_;
+        std::vector<Real> values_, antitheticValues_;
+    };
+
+    // inline definitions
+    template <class RNG, class S>
+    inline MonteCarloBatchModel<RNG, S>::MonteCarloBatchModel(
+                    ext::shared_ptr<path_generator_type> pathGenerator,
+                    ext::shared_ptr<path_pricer_type> pathPricer,
+                    stats_type sampleAccumulator,
+                    bool antitheticVariate)
+    : pathGenerator_(std::move(pathGenerator)),
+      pathPricer_(std::move(pathPricer)),
+      sampleAccumulator_(std::move(sampleAccumulator)),
+      isAntitheticVariate_(antitheticVariate),
+      values_(pathGenerator_->batchSize()) {
+        if (isAntitheticVariate_)
+            antitheticValues_.resize(values_.size());
+    }
+
+    template <class RNG, class S>
+    inline void MonteCarloBatchModel<RNG, S>::addSamples(Size samples) {
+        const Size batchSize = values_.size();
+        while (samples > 0) {
+            const sample_type& batch = pathGenerator_->next();
+            (*pathPricer_)(batch, &values_[0]);
+
+            if (isAntitheticVariate_) {
+                const sample_type& atBatch = pathGenerator_->antithetic();
+                (*pathPricer_)(atBatch, &antitheticValues_[0]);
+                for (Size i=0; i<batchSize; ++i)
+                    values_[i] = (values_[i]+antitheticValues_[i])/2.0;
+            }
+
+            // weights are the same for the direct and antithetic batch
+            const Size n = std::min(samples, batchSize);
+            for (Size i=0; i<n; ++i)
+                sampleAccumulator_.add(values_[i], batch.weight(i));
+            samples -= n;
+        }
+    }
+
+    template <class RNG, class S>
+    inline const typename MonteCarloBatchModel<RNG, S>::stats_type&
+    MonteCarloBatchModel<RNG, S>::sampleAccumulator() const {
+        return sampleAccumulator_;
+    }
+
+}
+
+
+#endif
@@ -28,10 +28,26 @@
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/shared_ptr.hpp>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // true if the RNG traits provide make_substream()
+        template <class RNG, class = void>
+        struct allows_substreams : std::false_type {};
+
+        template <class RNG>
+        struct allows_substreams<
+            RNG, typename std::enable_if<RNG::allowsSubstreams != 0>::type>
+        : std::true_type {};
+
+    }
+
     //! General-purpose Monte Carlo model for path samples
     /*! The template arguments of this class correspond to available
         policies for the particular model to be instantiated---i.e.,
@@ -46,6 +62,27 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        If more than one thread is requested, each call to
+        addSamples() splits the samples in as many contiguous blocks.
+        Each block is simulated by a copy of the path generator
+        drawing from its own substream, as returned by the
+        make_substream() method of the RNG traits: pseudo-random
+        generators are jumped ahead, while low-discrepancy ones are
+        skipped to the first sample of the block so that the blocks
+        partition the sequence that would be drawn serially.  The
+        sampled values are added to the accumulator in block order;
+        therefore, for a given seed and number of threads, results
+        are reproducible and don't depend on thread scheduling (or
+        on OpenMP being enabled at all.)  If the RNG traits don't
+        provide substreams (i.e., they don't declare a non-null
+        allowsSubstreams constant) the samples are always drawn
+        serially from the path generator, regardless of the number
+        of threads.
+
+        \warning with more than one thread, the path pricers and the
+                 underlying stochastic process are shared between
+                 threads and must be safe to use concurrently.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,16 +104,42 @@ namespace QuantLib {
             ext::shared_ptr<path_pricer_type> cvPathPricer = ext::shared_ptr<path_pricer_type>(),
             result_type cvOptionValue = result_type(),
             ext::shared_ptr<path_generator_type> cvPathGenerator =
-                ext::shared_ptr<path_generator_type>())
+                ext::shared_ptr<path_generator_type>(),
+            Size threads = 1)
         : pathGenerator_(std::move(pathGenerator)), pathPricer_(std::move(pathPricer)),
           sampleAccumulator_(std::move(sampleAccumulator)), isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(std::move(cvPathPricer)), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(std::move(cvPathGenerator)) {
+          cvPathGenerator_(std::move(cvPathGenerator)), threads_(threads) {
             isControlVariate_ = static_cast<bool>(cvPathPricer_);
+            QL_REQUIRE(threads_ > 0, "at least one thread is required");
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator() const;
       private:
+        typedef typename MC<RNG>::rsg_type rsg_type;
+        // collects the samples simulated by a single thread
+        class SampleBuffer {
+          public:
+            void add(const result_type& value, Real weight) {
+                samples_.emplace_back(value, weight);
+            }
+            void addTo(stats_type& accumulator) const {
+                for (const auto& sample : samples_)
+                    accumulator.add(sample.first, sample.second);
+            }
+          private:
+            std::vector<std::pair<result_type, Real> > samples_;
+        };
+        template <class Accumulator>
+        void simulate(Size samples,
+                      const path_generator_type& pathGenerator,
+                      const ext::shared_ptr<path_generator_type>& cvPathGenerator,
+                      Accumulator& accumulator) const;
+        // the parallel version is a template so that it's only
+        // instantiated for RNG traits providing substreams
+        void addSamplesInParallel(Size samples, std::false_type);
+        template <class Substreams>
+        void addSamplesInParallel(Size samples, Substreams);
         ext::shared_ptr<path_generator_type> pathGenerator_;
         ext::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -85,45 +148,140 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         ext::shared_ptr<path_generator_type> cvPathGenerator_;
+        Size threads_;
+        // used in multi-threaded mode
+        ext::shared_ptr<rsg_type> substreams_, cvSubstreams_;
+        BigNatural simulatedSamples_ = 0;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        if (threads_ > 1)
+            addSamplesInParallel(
+                samples,
+                std::integral_constant<
+                    bool, detail::allows_substreams<rng_traits>::value>());
+        else
+            simulate(samples, *pathGenerator_, cvPathGenerator_,
+                     sampleAccumulator_);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamplesInParallel(
+                                              Size samples, std::false_type) {
+        // no substreams available; the samples are drawn serially
+        simulate(samples, *pathGenerator_, cvPathGenerator_,
+                 sampleAccumulator_);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    template <class Accumulator>
+    inline void MonteCarloModel<MC,RNG,S>::simulate(
+                  Size samples,
+                  const path_generator_type& pathGenerator,
+                  const ext::shared_ptr<path_generator_type>& cvPathGenerator,
+                  Accumulator& accumulator) const {
         for(Size j = 1; j <= samples; j++) {
 
-            const sample_type& path = pathGenerator_->next();
+            const sample_type& path = pathGenerator.next();
             result_type price = (*pathPricer_)(path.value);
 
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
+                if (!cvPathGenerator) {
                     price += cvOptionValue_-(*cvPathPricer_)(path.value);
                 }
                 else {
-                    const sample_type& cvPath = cvPathGenerator_->next();
+                    const sample_type& cvPath = cvPathGenerator->next();
                     price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
                 }
             }
 
             if (isAntitheticVariate_) {
-                const sample_type& atPath = pathGenerator_->antithetic();
+                const sample_type& atPath = pathGenerator.antithetic();
                 result_type price2 = (*pathPricer_)(atPath.value);
                 if (isControlVariate_) {
-                    if (!cvPathGenerator_)
+                    if (!cvPathGenerator)
                         price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
                     else {
-                        const sample_type& cvPath = cvPathGenerator_->antithetic();
+                        const sample_type& cvPath = cvPathGenerator->antithetic();
                         price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
                     }
                 }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
+                accumulator.add((price+price2)/2.0, path.weight);
             } else {
-                sampleAccumulator_.add(price, path.weight);
+                accumulator.add(price, path.weight);
             }
         }
     }
 
+    template <template <class> class MC, class RNG, class S>
+    template <class Substreams>
+    inline void MonteCarloModel<MC,RNG,S>::addSamplesInParallel(
+                                                 Size samples, Substreams) {
+        // dependent on Substreams, so that make_substream is only
+        // looked up for RNG traits providing it
+        typedef typename std::conditional<Substreams::value,
+                                          rng_traits, void>::type traits;
+
+        // the original generators are never drawn from; they are
+        // only used as the starting point of the substreams
+        if (!substreams_) {
+            substreams_ = ext::make_shared<rsg_type>(
+                                      pathGenerator_->sequenceGenerator());
+            if (cvPathGenerator_)
+                cvSubstreams_ = ext::make_shared<rsg_type>(
+                                    cvPathGenerator_->sequenceGenerator());
+        }
+
+        std::vector<Size> blocks(threads_);
+        std::vector<ext::shared_ptr<path_generator_type> >
+            generators(threads_), cvGenerators(threads_);
+        for (Size i=0; i<threads_; ++i) {
+            Size begin = (samples*i)/threads_,
+                 end = (samples*(i+1))/threads_;
+            blocks[i] = end-begin;
+            generators[i] = ext::make_shared<path_generator_type>(
+                *pathGenerator_,
+                traits::make_substream(*substreams_,
+                                           simulatedSamples_+begin));
+            if (cvPathGenerator_)
+                cvGenerators[i] = ext::make_shared<path_generator_type>(
+                    *cvPathGenerator_,
+                    traits::make_substream(*cvSubstreams_,
+                                               simulatedSamples_+begin));
+        }
+
+#ifdef _OPENMP
+        // lazy objects used by the pricer and the process must be
+        // calculated before entering the parallel region; a path is
+        // priced on a copy so that no substream is consumed.
+        if (samples > 0) {
+            path_generator_type warmup(*generators[0]);
+            (*pathPricer_)(warmup.next().value);
+        }
+#endif
+
+        std::vector<SampleBuffer> buffers(threads_);
+        std::vector<std::string> errors(threads_);
+        #pragma omp parallel for num_threads(threads_) schedule(static, 1)
+        for (long i=0; i<(long)threads_; i++) {
+            try {
+                simulate(blocks[i], *generators[i], cvGenerators[i],
+                         buffers[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+        for (Size i=0; i<threads_; ++i)
+            QL_REQUIRE(errors[i].empty(), errors[i]);
+
+        for (Size i=0; i<threads_; ++i)
+            buffers[i].addTo(sampleAccumulator_);
+        simulatedSamples_ += samples;
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline const typename MonteCarloModel<MC,RNG,S>::stats_type&
     MonteCarloModel<MC,RNG,S>::sampleAccumulator() const {
@@ -55,8 +55,11 @@ namespace QuantLib {
                            const TimeGrid&,
                            GSG generator,
                            bool brownianBridge = false);
+        //! copy of the given generator drawing from another sequence
+        MultiPathGenerator(const MultiPathGenerator&, GSG generator);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        const GSG& sequenceGenerator() const { return generator_; }
       private:
         const sample_type& next(bool antithetic) const;
         bool brownianBridge_;
@@ -87,6 +90,18 @@ namespace QuantLib {
                    "no times given");
     }
 
+    template <class GSG>
+    MultiPathGenerator<GSG>::MultiPathGenerator(
+                                          const MultiPathGenerator& other,
+                                          GSG generator)
+    : MultiPathGenerator(other) {
+        QL_REQUIRE(generator.dimension() == generator_.dimension(),
+                   "dimension (" << generator.dimension()
+                   << ") is not equal to (" << generator_.dimension()
+                   << ") the dimension of the copied generator");
+        generator_ = std::move(generator);
+    }
+
     template <class GSG>
     inline const typename MultiPathGenerator<GSG>::sample_type&
     MultiPathGenerator<GSG>::next() const {
@@ -0,0 +1,114 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathbatch.hpp
+    \brief Batch of paths stored as a structure of arrays
+*/
+
+#ifndef quantlib_montecarlo_path_batch_hpp
+#define quantlib_montecarlo_path_batch_hpp
+
+#include <ql/timegrid.hpp>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! batch of single- or multi-asset paths
+    /*! The values are stored as a structure of arrays: for each
+        point of the time grid and each asset, the values of all the
+        paths in the batch are contiguous.  This allows path
+        generators and pricers to work on all the paths at once in
+        vectorizable loops.
+
+        \ingroup mcarlo
+
+        \note each path includes the initial asset values as its first
+              point.
+    */
+    class PathBatch {
+      public:
+        PathBatch(Size nAssets, TimeGrid timeGrid, Size batchSize);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return nAssets_; }
+        Size pathSize() const { return timeGrid_.size(); }
+        Size batchSize() const { return batchSize_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //! time at the \f$ i \f$-th point
+        Time time(Size i) const { return timeGrid_[i]; }
+        //! value of the given asset at the \f$ i \f$-th point of a path
+        Real value(Size path, Size asset, Size i) const;
+        Real& value(Size path, Size asset, Size i);
+        /*! values of the given asset at the \f$ i \f$-th point for
+            all the paths in the batch */
+        const Real* values(Size asset, Size i) const;
+        Real* values(Size asset, Size i);
+        /*! values of all assets at the \f$ i \f$-th point, stored by
+            asset; this is the layout used by
+            StochasticProcess::evolveBatch. */
+        const Real* state(Size i) const;
+        Real* state(Size i);
+        //! weight of the given path
+        Real weight(Size path) const { return weights_[path]; }
+        Real& weight(Size path) { return weights_[path]; }
+        //@}
+      private:
+        Size nAssets_, batchSize_;
+        TimeGrid timeGrid_;
+        std::vector<Real> values_, weights_;
+    };
+
+
+    // inline definitions
+
+    inline PathBatch::PathBatch(Size nAssets, TimeGrid timeGrid, Size batchSize)
+    : nAssets_(nAssets), batchSize_(batchSize), timeGrid_(std::move(timeGrid)),
+      values_(nAssets_ * timeGrid_.size() * batchSize_),
+      weights_(batchSize_, 1.0) {
+        QL_REQUIRE(nAssets_ > 0, "number of assets must be positive");
+        QL_REQUIRE(batchSize_ > 0, "batch size must be positive");
+    }
+
+    inline Real PathBatch::value(Size path, Size asset, Size i) const {
+        return values_[(i*nAssets_ + asset)*batchSize_ + path];
+    }
+
+    inline Real& PathBatch::value(Size path, Size asset, Size i) {
+        return values_[(i*nAssets_ + asset)*batchSize_ + path];
+    }
+
+    inline const Real* PathBatch::values(Size asset, Size i) const {
+        return &values_[(i*nAssets_ + asset)*batchSize_];
+    }
+
+    inline Real* PathBatch::values(Size asset, Size i) {
+        return &values_[(i*nAssets_ + asset)*batchSize_];
+    }
+
+    inline const Real* PathBatch::state(Size i) const {
+        return &values_[i*nAssets_*batchSize_];
+    }
+
+    inline Real* PathBatch::state(Size i) {
+        return &values_[i*nAssets_*batchSize_];
+    }
+
+}
+
+
+#endif
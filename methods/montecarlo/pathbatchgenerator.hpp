@@ -0,0 +1,166 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathbatchgenerator.hpp
+    \brief Generates batches of random paths
+*/
+
+#ifndef quantlib_montecarlo_path_batch_generator_hpp
+#define quantlib_montecarlo_path_batch_generator_hpp
+
+#include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/pathbatch.hpp>
+#include <ql/stochasticprocess.hpp>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Generates batches of random paths from a sequence generator
+    /*! Each call to next() draws one sequence per path and evolves
+        all the paths of the batch together, one time step at a time,
+        through StochasticProcess::evolveBatch.  For a given sequence
+        generator, the paths are the same that would be returned by
+        PathGenerator (for one-dimensional processes) or
+        MultiPathGenerator.
+
+        The Brownian bridge is only supported for one-factor
+        processes.
+
+        \ingroup mcarlo
+    */
+    template <class GSG>
+    class PathBatchGenerator {
+      public:
+        typedef PathBatch sample_type;
+        PathBatchGenerator(ext::shared_ptr<StochasticProcess> process,
+                           const TimeGrid& timeGrid,
+                           GSG generator,
+                           Size batchSize,
+                           bool brownianBridge = false);
+        const sample_type& next() const;
+        const sample_type& antithetic() const;
+        Size batchSize() const { return next_.batchSize(); }
+        const TimeGrid& timeGrid() const { return next_.timeGrid(); }
+      private:
+        const sample_type& next(bool antithetic) const;
+        bool brownianBridge_;
+        ext::shared_ptr<StochasticProcess> process_;
+        GSG generator_;
+        Size factors_;
+        mutable sample_type next_;
+        // Brownian increments, stored as [time step][factor][path]
+        mutable std::vector<Real> dw_, negatedDw_;
+        mutable std::vector<Real> temp_;
+        BrownianBridge bb_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    PathBatchGenerator<GSG>::PathBatchGenerator(
+                                ext::shared_ptr<StochasticProcess> process,
+                                const TimeGrid& timeGrid,
+                                GSG generator,
+                                Size batchSize,
+                                bool brownianBridge)
+    : brownianBridge_(brownianBridge), process_(std::move(process)),
+      generator_(std::move(generator)), factors_(process_->factors()),
+      next_(process_->size(), timeGrid, batchSize),
+      dw_(generator_.dimension()*batchSize),
+      temp_(generator_.dimension()), bb_(timeGrid) {
+
+        QL_REQUIRE(timeGrid.size() > 1, "no times given");
+        QL_REQUIRE(generator_.dimension() == factors_*(timeGrid.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << factors_ << " * " << timeGrid.size()-1
+                   << ") the number of factors "
+                   << "times the number of time steps");
+        QL_REQUIRE(!brownianBridge_ || factors_ == 1,
+                   "Brownian bridge only supported for one-factor processes");
+    }
+
+    template <class GSG>
+    inline const typename PathBatchGenerator<GSG>::sample_type&
+    PathBatchGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const typename PathBatchGenerator<GSG>::sample_type&
+    PathBatchGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const typename PathBatchGenerator<GSG>::sample_type&
+    PathBatchGenerator<GSG>::next(bool antithetic) const {
+
+        const Size n = next_.batchSize();
+        const Size m = next_.assetNumber();
+        const Size dimension = temp_.size();
+
+        const Real* dw;
+        if (!antithetic) {
+            // draw one sequence per path and store it transposed
+            typedef typename GSG::sample_type sequence_type;
+            for (Size p=0; p<n; ++p) {
+                const sequence_type& sequence =
+                    generator_.nextSequence();
+                if (brownianBridge_) {
+                    bb_.transform(sequence.value.begin(),
+                                  sequence.value.end(),
+                                  temp_.begin());
+                } else {
+                    std::copy(sequence.value.begin(),
+                              sequence.value.end(),
+                              temp_.begin());
+                }
+                for (Size k=0; k<dimension; ++k)
+                    dw_[k*n+p] = temp_[k];
+                next_.weight(p) = sequence.weight;
+            }
+            dw = &dw_[0];
+        } else {
+            // reuse the last draws with the opposite sign
+            negatedDw_.resize(dw_.size());
+            std::transform(dw_.begin(), dw_.end(), negatedDw_.begin(),
+                           std::negate<>());
+            dw = &negatedDw_[0];
+        }
+
+        Array x0 = process_->initialValues();
+        for (Size j=0; j<m; ++j)
+            std::fill(next_.values(j, 0), next_.values(j, 0)+n, x0[j]);
+
+        const TimeGrid& timeGrid = next_.timeGrid();
+        for (Size i=1; i<next_.pathSize(); ++i) {
+            process_->evolveBatch(timeGrid[i-1], next_.state(i-1),
+                                  timeGrid.dt(i-1), dw + (i-1)*factors_*n,
+                                  next_.state(i), n);
+        }
+
+        return next_;
+    }
+
+}
+
+
+#endif
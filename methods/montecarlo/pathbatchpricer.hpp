@@ -0,0 +1,48 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathbatchpricer.hpp
+    \brief base class for batch path pricers
+*/
+
+#ifndef quantlib_montecarlo_path_batch_pricer_hpp
+#define quantlib_montecarlo_path_batch_pricer_hpp
+
+#include <ql/methods/montecarlo/pathbatch.hpp>
+
+namespace QuantLib {
+
+    //! base class for batch path pricers
+    /*! Returns the values of an option on all the paths of a batch;
+        the \f$ i \f$-th element of the output must be set to the
+        value on the \f$ i \f$-th path.  Derived classes are expected
+        to loop over the paths in the innermost loop, so that the
+        calculation can be vectorized.
+
+        \ingroup mcarlo
+    */
+    class PathBatchPricer {
+      public:
+        virtual ~PathBatchPricer() = default;
+        virtual void operator()(const PathBatch& paths,
+                                Real* values) const = 0;
+    };
+
+}
+
+
+#endif
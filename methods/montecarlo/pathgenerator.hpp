@@ -55,12 +55,15 @@ namespace QuantLib {
                       TimeGrid timeGrid,
                       GSG generator,
                       bool brownianBridge);
+        //! copy of the given generator drawing from another sequence
+        PathGenerator(const PathGenerator&, GSG generator);
         //! \name inspectors
         //@{
         const sample_type& next() const;
         const sample_type& antithetic() const;
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
+        const GSG& sequenceGenerator() const { return generator_; }
         //@}
       private:
         const sample_type& next(bool antithetic) const;
@@ -106,6 +109,17 @@ namespace QuantLib {
                    << ") != timeSteps (" << timeGrid_.size()-1 << ")");
     }
 
+    template <class GSG>
+    PathGenerator<GSG>::PathGenerator(const PathGenerator& other,
+                                      GSG generator)
+    : PathGenerator(other) {
+        QL_REQUIRE(generator.dimension() == dimension_,
+                   "sequence generator dimensionality ("
+                   << generator.dimension() << ") != timeSteps ("
+                   << dimension_ << ")");
+        generator_ = std::move(generator);
+    }
+
     template <class GSG>
     const typename PathGenerator<GSG>::sample_type&
     PathGenerator<GSG>::next() const {
@@ -0,0 +1,235 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/patterns/lazyobjectgraph.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace QuantLib {
+
+    namespace {
+
+        template <class T>
+        void sortAndRemoveDuplicates(std::vector<T>& v) {
+            std::sort(v.begin(), v.end());
+            v.erase(std::unique(v.begin(), v.end()), v.end());
+        }
+
+    }
+
+    struct LazyObjectGraph::Builder {
+        // index of each node, or Null<Size>() while being built
+        std::unordered_map<const LazyObject*, Size> indices;
+        // lazy objects and inputs reached through intermediate
+        // observers; empty while being built
+        struct Expansion {
+            std::vector<Size> dependencies;
+            std::vector<const Observable*> inputs;
+            bool complete = false;
+        };
+        std::unordered_map<const Observer*, Expansion> expansions;
+    };
+
+    LazyObjectGraph::LazyObjectGraph(
+                   const std::vector<ext::shared_ptr<LazyObject> >& objects) {
+        Builder builder;
+        for (const auto& object : objects) {
+            QL_REQUIRE(object, "null lazy object given");
+            addNode(object, builder);
+        }
+
+        for (Size i=0; i<nodes_.size(); ++i) {
+            Size level = nodes_[i].level;
+            if (level >= levelIndices_.size())
+                levelIndices_.resize(level+1);
+            levelIndices_[level].push_back(i);
+        }
+        levels_.resize(levelIndices_.size());
+        for (Size l=0; l<levelIndices_.size(); ++l) {
+            for (Size i : levelIndices_[l])
+                levels_[l].push_back(nodes_[i].object);
+        }
+
+        indices_ = std::move(builder.indices);
+    }
+
+    Size LazyObjectGraph::addNode(const ext::shared_ptr<LazyObject>& object,
+                                  Builder& builder) {
+        auto found = builder.indices.find(object.get());
+        if (found != builder.indices.end()) {
+            QL_REQUIRE(found->second != Null<Size>(),
+                       "cycle detected in lazy-object dependencies");
+            return found->second;
+        }
+        builder.indices[object.get()] = Null<Size>();
+
+        std::vector<Size> dependencies;
+        std::vector<const Observable*> inputs;
+        expand(*object, dependencies, inputs, builder);
+
+        Node node;
+        node.object = object;
+        for (Size d : dependencies)
+            node.level = std::max(node.level, nodes_[d].level + 1);
+        node.dependencies = std::move(dependencies);
+        node.inputs = std::move(inputs);
+
+        // dependencies are added first, so indices are in
+        // topological order
+        Size index = nodes_.size();
+        nodes_.push_back(std::move(node));
+        builder.indices[object.get()] = index;
+        return index;
+    }
+
+    void LazyObjectGraph::expand(const Observer& observer,
+                                 std::vector<Size>& dependencies,
+                                 std::vector<const Observable*>& inputs,
+                                 Builder& builder) {
+        for (const auto& observable : observer.observables_) {
+            auto lazy = ext::dynamic_pointer_cast<LazyObject>(observable);
+            if (lazy != nullptr) {
+                dependencies.push_back(addNode(lazy, builder));
+                continue;
+            }
+
+            const auto* intermediate =
+                dynamic_cast<const Observer*>(observable.get());
+            if (intermediate == nullptr) {
+                inputs.push_back(observable.get());
+                continue;
+            }
+
+            // e.g., a handle link or an index; it's shared by many
+            // observers, so its expansion is cached
+            auto found = builder.expansions.find(intermediate);
+            if (found == builder.expansions.end()) {
+                builder.expansions[intermediate];
+                Builder::Expansion expansion;
+                expand(*intermediate, expansion.dependencies,
+                       expansion.inputs, builder);
+                expansion.complete = true;
+                found = builder.expansions.find(intermediate);
+                found->second = std::move(expansion);
+            }
+            QL_REQUIRE(found->second.complete,
+                       "cycle detected in lazy-object dependencies");
+            dependencies.insert(dependencies.end(),
+                                found->second.dependencies.begin(),
+                                found->second.dependencies.end());
+            inputs.insert(inputs.end(),
+                          found->second.inputs.begin(),
+                          found->second.inputs.end());
+        }
+        sortAndRemoveDuplicates(dependencies);
+        sortAndRemoveDuplicates(inputs);
+    }
+
+    const std::vector<ext::shared_ptr<LazyObject> >&
+    LazyObjectGraph::level(Size i) const {
+        QL_REQUIRE(i < levels_.size(),
+                   "level " << i << " out of range [0, "
+                   << levels_.size() << ")");
+        return levels_[i];
+    }
+
+    void LazyObjectGraph::recalculate() const {
+        calculate(levelIndices_);
+    }
+
+    std::vector<bool> LazyObjectGraph::dependsOn(
+              const std::vector<ext::shared_ptr<LazyObject> >& objects,
+              const std::vector<ext::shared_ptr<Observable> >& changed) const {
+        std::vector<bool> affected = affectedNodes(changed);
+        std::vector<bool> result(objects.size());
+        for (Size i=0; i<objects.size(); ++i) {
+            auto found = indices_.find(objects[i].get());
+            QL_REQUIRE(found != indices_.end(),
+                       "lazy object #" << i << " is not in the graph");
+            result[i] = affected[found->second];
+        }
+        return result;
+    }
+
+    std::vector<bool> LazyObjectGraph::affectedNodes(
+              const std::vector<ext::shared_ptr<Observable> >& changed) const {
+        std::unordered_set<const Observable*> changedSet;
+        for (const auto& observable : changed)
+            changedSet.insert(observable.get());
+
+        // nodes are in topological order, so a single pass is enough
+        std::vector<bool> affected(nodes_.size(), false);
+        for (Size i=0; i<nodes_.size(); ++i) {
+            const Node& node = nodes_[i];
+            bool isAffected =
+                changedSet.count(node.object.get()) != 0;
+            for (Size j=0; j<node.inputs.size() && !isAffected; ++j)
+                isAffected = changedSet.count(node.inputs[j]) != 0;
+            for (Size j=0; j<node.dependencies.size() && !isAffected; ++j)
+                isAffected = affected[node.dependencies[j]];
+            affected[i] = isAffected;
+        }
+        return affected;
+    }
+
+    void LazyObjectGraph::recalculate(
+              const std::vector<ext::shared_ptr<Observable> >& changed) const {
+        std::vector<bool> affected = affectedNodes(changed);
+        std::vector<std::vector<Size> > levels(levelIndices_.size());
+        for (Size i=0; i<nodes_.size(); ++i) {
+            if (affected[i])
+                levels[nodes_[i].level].push_back(i);
+        }
+        calculate(levels);
+    }
+
+    void LazyObjectGraph::calculate(
+                       const std::vector<std::vector<Size> >& levels) const {
+        for (const auto& level : levels) {
+            const Size n = level.size();
+            std::vector<std::string> errors(n);
+
+            // calculations notify observers (e.g., when a bootstrap
+            // relinks its helpers) which is only safe to do from
+            // several threads with the thread-safe observer pattern
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            #pragma omp parallel for
+            #endif
+            for (long i=0; i<(long)n; i++) {
+                try {
+                    nodes_[level[i]].object->calculate();
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                } catch (...) {
+                    errors[i] = "unknown error";
+                }
+            }
+
+            // the next levels would calculate the failed nodes
+            // again, concurrently; we stop here
+            for (Size i=0; i<n; ++i) {
+                QL_REQUIRE(errors[i].empty(),
+                           "could not calculate lazy object: "
+                           << errors[i]);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,114 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lazyobjectgraph.hpp
+    \brief dependency graph of lazy objects
+*/
+
+#ifndef quantlib_lazy_object_graph_hpp
+#define quantlib_lazy_object_graph_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Dependency graph of lazy objects
+    /*! The graph is built from the observer registrations of the
+        given lazy objects: a lazy object depends on the lazy objects
+        it registered with, either directly or through other
+        observers which are not lazy objects (e.g., handles or
+        indexes).  The lazy objects found along the way (e.g., the
+        curves on which a set of instruments depend) are added to the
+        graph.  Observables which are neither lazy objects nor
+        observers (e.g., quotes) are the inputs of the graph.
+
+        Each node is assigned a level such that it only depends on
+        nodes of lower levels; nodes of the same level are
+        independent and can be calculated in parallel.  When OpenMP
+        and the thread-safe observer pattern are both enabled,
+        recalculate() does so; otherwise, it calculates the nodes
+        sequentially in topological order, since calculations can
+        send notifications to shared observers.
+
+        The graph is a snapshot of the registrations when it was
+        built; it must be rebuilt if they change.
+
+        \warning nodes of the same level might be calculated
+                 concurrently.
+                 They must not share mutable state; for instance,
+                 instruments sharing the same pricing engine must not
+                 be added to the same graph.
+
+        \ingroup patterns
+    */
+    class LazyObjectGraph {
+      public:
+        explicit LazyObjectGraph(
+                      const std::vector<ext::shared_ptr<LazyObject> >& objects);
+        //! \name Inspectors
+        //@{
+        //! number of nodes, including the dependencies found
+        Size size() const { return nodes_.size(); }
+        Size levels() const { return levels_.size(); }
+        //! the nodes of the i-th level
+        const std::vector<ext::shared_ptr<LazyObject> >& level(Size i) const;
+        /*! returns, for each of the given nodes, whether it depends
+            directly or indirectly on any of the given observables.
+        */
+        std::vector<bool> dependsOn(
+             const std::vector<ext::shared_ptr<LazyObject> >& objects,
+             const std::vector<ext::shared_ptr<Observable> >& changed) const;
+        //@}
+        //! \name Calculations
+        //@{
+        //! calculates all nodes which are not calculated yet
+        void recalculate() const;
+        /*! calculates the nodes which depend, directly or
+            indirectly, on any of the given observables.
+        */
+        void recalculate(
+             const std::vector<ext::shared_ptr<Observable> >& changed) const;
+        //@}
+      private:
+        struct Node {
+            ext::shared_ptr<LazyObject> object;
+            std::vector<Size> dependencies;
+            std::vector<const Observable*> inputs;
+            Size level = 0;
+        };
+        struct Builder;
+        Size addNode(const ext::shared_ptr<LazyObject>& object,
+                     Builder& builder);
+        void expand(const Observer& observer,
+                    std::vector<Size>& dependencies,
+                    std::vector<const Observable*>& inputs,
+                    Builder& builder);
+        std::vector<bool> affectedNodes(
+             const std::vector<ext::shared_ptr<Observable> >& changed) const;
+        void calculate(const std::vector<std::vector<Size> >& levels) const;
+        std::vector<Node> nodes_;
+        std::unordered_map<const LazyObject*, Size> indices_;
+        std::vector<std::vector<Size> > levelIndices_;
+        std::vector<std::vector<ext::shared_ptr<LazyObject> > > levels_;
+    };
+
+}
+
+
+#endif
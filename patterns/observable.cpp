@@ -34,7 +34,13 @@ namespace QuantLib {
             bool successful = true;
             std::string errMsg;
 
-            for (auto* deferredObserver : deferredObservers_) {
+            // the loop is by index since an update might cause other
+            // observers to be unregistered, i.e., set to null
+            for (Size i=0; i<deferredObservers_.size(); ++i) {
+                Observer* deferredObserver = deferredObservers_[i];
+                if (deferredObserver == nullptr)
+                    continue;
+                deferredObserver->isDeferred_ = false;
                 try {
                     deferredObserver->update();
                 } catch (std::exception& e) {
@@ -58,10 +64,21 @@ namespace QuantLib {
             // if updates are only deferred, flag this for later notification
             // these are held centrally by the settings singleton
             settings_.registerDeferredObservers(observers_);
+        } else if (settings_.openTransactions_ > 0) {
+            // a transaction is open; collect the observers
+            settings_.registerPendingObservers(observers_);
         } else if (!observers_.empty()) {
             bool successful = true;
             std::string errMsg;
-            for (auto* observer : observers_) {
+            // observers registering during the loop are appended and
+            // not notified; observers unregistering are set to null
+            // and removed at the end of the outermost notification
+            ++notificationDepth_;
+            const Size n = observers_.size();
+            for (Size i=0; i<n; ++i) {
+                Observer* observer = observers_[i];
+                if (observer == nullptr)
+                    continue;
                 try {
                     observer->update();
                 } catch (std::exception& e) {
@@ -78,11 +95,67 @@ namespace QuantLib {
                     successful = false;
                 }
             }
+            if (--notificationDepth_ == 0 &&
+                2*unregisteredObservers_ > observers_.size())
+                removeUnregisteredObservers();
             QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
         }
     }
 
+
+    void ObservableSettings::notifyPendingObservers() {
+        // notifications sent during the loop are collected as well,
+        // which is why the transaction is kept open while looping
+        ++openTransactions_;
+
+        bool successful = true;
+        std::string errMsg;
+
+        // the loop is by index since updates can append observers or
+        // set unregistered ones to null.  The flags are only reset at
+        // the end so that each observer is notified at most once.
+        for (Size i=0; i<pendingObservers_.size(); ++i) {
+            Observer* pendingObserver = pendingObservers_[i];
+            if (pendingObserver == nullptr)
+                continue;
+            try {
+                pendingObserver->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+
+        for (auto* pendingObserver : pendingObservers_) {
+            if (pendingObserver != nullptr)
+                pendingObserver->isPending_ = false;
+        }
+        pendingObservers_.clear();
+        --openTransactions_;
+
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+
+    ObservableTransaction::ObservableTransaction() {
+        ++ObservableSettings::instance().openTransactions_;
+    }
+
+    void ObservableTransaction::commit() {
+        if (committed_)
+            return;
+        committed_ = true;
+
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (--settings.openTransactions_ == 0 &&
+            !settings.pendingObservers_.empty())
+            settings.notifyPendingObservers();
+    }
+
 }
 
 #else
@@ -199,6 +272,24 @@ namespace QuantLib {
         // register with this object
     }
 
+
+    ObservableTransaction::ObservableTransaction() {
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (settings.updatesEnabled()) {
+            settings.disableUpdates(true);
+            deferring_ = true;
+        }
+    }
+
+    void ObservableTransaction::commit() {
+        if (committed_)
+            return;
+        committed_ = true;
+
+        if (deferring_)
+            ObservableSettings::instance().enableUpdates();
+    }
+
 }
 
 #endif
@@ -39,13 +39,27 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
 namespace QuantLib {
 
     class Observer;
     class ObservableSettings;
 
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! Observers are stored in a flat vector and notified in the
+        order in which they registered.  Unregistered observers are
+        marked as removed and the storage is compacted when more
+        than half of it is unused and no notification is running.
+        When many observers are registered, their positions are also
+        kept in a hash map so that unregistering them doesn't need
+        a linear search.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
         friend class ObservableSettings;
@@ -60,18 +74,32 @@ namespace QuantLib {
         */
         void notifyObservers();
       private:
-        typedef std::set<Observer*> set_type;
-        typedef set_type::iterator iterator;
-        std::pair<iterator, bool> registerObserver(Observer*);
+        typedef std::vector<Observer*> set_type;
+        void registerObserver(Observer*);
         Size unregisterObserver(Observer*);
+        void removeUnregisteredObservers();
+        void indexObservers();
         set_type observers_;
+        // only filled when more than indexingThreshold_ observers
+        // are registered; a linear search is faster below that
+        std::unordered_map<Observer*, Size> positions_;
+        static const Size indexingThreshold_ = 32;
+        Size unregisteredObservers_ = 0;
+        Size notificationDepth_ = 0;
         ObservableSettings& settings_;
     };
 
     //! global repository for run-time library settings
+    /*! When updates are disabled and deferred, the notifications
+        sent by all observables are collected and each observer is
+        notified only once when updates are enabled again.  This can
+        be used to batch notifications, e.g., when several quotes are
+        set in a row.
+    */
     class ObservableSettings : public Singleton<ObservableSettings> {
         friend class Singleton<ObservableSettings>;
         friend class Observable;
+        friend class Observer;
       public:
         void disableUpdates(bool deferred=false) {
             updatesEnabled_  = false;
@@ -84,14 +112,21 @@ namespace QuantLib {
 
       private:
         ObservableSettings() = default;
+        friend class ObservableTransaction;
 
-        typedef std::unordered_set<Observer*> set_type;
-        typedef set_type::iterator iterator;
+        // each observer is stored only once, see Observer::isDeferred_
+        typedef std::vector<Observer*> set_type;
 
         void registerDeferredObservers(const Observable::set_type& observers);
         void unregisterDeferredObserver(Observer*);
 
-        set_type deferredObservers_;
+        // each observer is stored only once, see Observer::isPending_
+        void registerPendingObservers(const Observable::set_type& observers);
+        void unregisterPendingObserver(Observer*);
+        void notifyPendingObservers();
+
+        set_type deferredObservers_, pendingObservers_;
+        Size openTransactions_ = 0;
 
         bool updatesEnabled_ = true, updatesDeferred_ = false;
     };
@@ -99,6 +134,9 @@ namespace QuantLib {
     //! Object that gets notified when a given observable changes
     /*! \ingroup patterns */
     class Observer {
+        friend class Observable;
+        friend class ObservableSettings;
+        friend class LazyObjectGraph;
       public:
         /*! \deprecated Don't use `set_type`; it's not used in the public interface
                         anyway.  Use `Observer::iterator` if you need to
@@ -146,6 +184,14 @@ namespace QuantLib {
         QL_DEPRECATED_DISABLE_WARNING
         set_type observables_;
         QL_DEPRECATED_ENABLE_WARNING
+        // whether the observer is waiting for a deferred notification,
+        // and its position in ObservableSettings::deferredObservers_
+        bool isDeferred_ = false;
+        Size deferredPosition_ = 0;
+        // whether the observer was collected by the open transaction,
+        // and its position in ObservableSettings::pendingObservers_
+        bool isPending_ = false;
+        Size pendingPosition_ = 0;
     };
 
 
@@ -155,12 +201,34 @@ namespace QuantLib {
 
     inline void ObservableSettings::registerDeferredObservers(const Observable::set_type& observers) {
         if (updatesDeferred()) {
-            deferredObservers_.insert(observers.begin(), observers.end());
+            for (auto* observer : observers) {
+                if (observer != nullptr && !observer->isDeferred_) {
+                    observer->isDeferred_ = true;
+                    observer->deferredPosition_ = deferredObservers_.size();
+                    deferredObservers_.push_back(observer);
+                }
+            }
         }
     }
 
     inline void ObservableSettings::unregisterDeferredObserver(Observer* o) {
-        deferredObservers_.erase(o);
+        deferredObservers_[o->deferredPosition_] = nullptr;
+        o->isDeferred_ = false;
+    }
+
+    inline void ObservableSettings::registerPendingObservers(const Observable::set_type& observers) {
+        for (auto* observer : observers) {
+            if (observer != nullptr && !observer->isPending_) {
+                observer->isPending_ = true;
+                observer->pendingPosition_ = pendingObservers_.size();
+                pendingObservers_.push_back(observer);
+            }
+        }
+    }
+
+    inline void ObservableSettings::unregisterPendingObserver(Observer* o) {
+        pendingObservers_[o->pendingPosition_] = nullptr;
+        o->isPending_ = false;
     }
 
     inline Observable::Observable(const Observable&)
@@ -185,16 +253,67 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<Observable::iterator, bool>
-    Observable::registerObserver(Observer* o) {
-        return observers_.insert(o);
+    inline void Observable::registerObserver(Observer* o) {
+        // uniqueness is guaranteed by the observer, which only
+        // registers once with a given observable
+        observers_.push_back(o);
+        if (!positions_.empty())
+            positions_[o] = observers_.size()-1;
+        else if (observers_.size() > indexingThreshold_)
+            indexObservers();
     }
 
     inline Size Observable::unregisterObserver(Observer* o) {
-        if (settings_.updatesDeferred())
+        // during the flush in enableUpdates() the observer might
+        // still be waiting for notifications from other observables
+        if (o->isDeferred_ && settings_.updatesDeferred())
             settings_.unregisterDeferredObserver(o);
+        if (o->isPending_)
+            settings_.unregisterPendingObserver(o);
+
+        Size position;
+        if (!positions_.empty()) {
+            auto i = positions_.find(o);
+            if (i == positions_.end())
+                return 0;
+            position = i->second;
+            positions_.erase(i);
+        } else {
+            // observers are often unregistered in the reverse order of
+            // registration, so we start looking from the end
+            auto i = std::find(observers_.rbegin(), observers_.rend(), o);
+            if (i == observers_.rend())
+                return 0;
+            position = std::distance(i, observers_.rend()) - 1;
+        }
+
+        // erasing would invalidate a running notification loop and
+        // make the removal linear; the slot is cleared instead
+        observers_[position] = nullptr;
+        ++unregisteredObservers_;
+        if (notificationDepth_ == 0 &&
+            2*unregisteredObservers_ > observers_.size())
+            removeUnregisteredObservers();
+        return 1;
+    }
 
-        return observers_.erase(o);
+    inline void Observable::removeUnregisteredObservers() {
+        observers_.erase(std::remove(observers_.begin(), observers_.end(),
+                                     static_cast<Observer*>(nullptr)),
+                         observers_.end());
+        unregisteredObservers_ = 0;
+        indexObservers();
+    }
+
+    inline void Observable::indexObservers() {
+        positions_.clear();
+        if (observers_.size() > indexingThreshold_) {
+            positions_.reserve(observers_.size());
+            for (Size i=0; i<observers_.size(); ++i) {
+                if (observers_[i] != nullptr)
+                    positions_[observers_[i]] = i;
+            }
+        }
     }
 
 
@@ -216,13 +335,18 @@ namespace QuantLib {
     inline Observer::~Observer() {
         for (const auto& observable : observables_)
             observable->unregisterObserver(this);
+        // a destroyed observer can't be notified in any case
+        if (isDeferred_)
+            ObservableSettings::instance().unregisterDeferredObserver(this);
     }
 
     inline std::pair<Observer::iterator, bool>
     Observer::registerWith(const ext::shared_ptr<Observable>& h) {
         if (h != nullptr) {
-            h->registerObserver(this);
-            return observables_.insert(h);
+            std::pair<iterator, bool> result = observables_.insert(h);
+            if (result.second)
+                h->registerObserver(this);
+            return result;
         }
         return std::make_pair(observables_.end(), false);
     }
@@ -237,9 +361,10 @@ namespace QuantLib {
 
     inline
     Size Observer::unregisterWith(const ext::shared_ptr<Observable>& h) {
-        if (h != nullptr)
+        Size erased = observables_.erase(h);
+        if (h != nullptr && erased != 0)
             h->unregisterObserver(this);
-        return observables_.erase(h);
+        return erased;
     }
 
     inline void Observer::unregisterWithAll() {
@@ -272,6 +397,7 @@ namespace QuantLib {
     class Observer : public ext::enable_shared_from_this<Observer> {
         friend class Observable;
         friend class ObservableSettings;
+        friend class LazyObjectGraph;
       public:
         /*! \deprecated Don't use `set_type`; it's not used in the public interface
                         anyway.  Use `Observer::iterator` if you need to capture
@@ -588,4 +714,69 @@ namespace QuantLib {
     }
 }
 #endif
+
+namespace QuantLib {
+
+    //! Scoped batch of notifications
+    /*! While a transaction is open, the notifications sent by
+        observables (e.g., by SimpleQuote::setValue) are collected
+        instead of being forwarded.  When the transaction is
+        committed, each collected observer is notified once; the
+        notifications it sends in turn are collected as well, so
+        that each observer in the dependency graph is notified at
+        most once.  For instance, a curve bootstrapped on several
+        quotes set inside a transaction is invalidated only once.
+
+        Transactions can be nested; notifications are only sent when
+        the outermost transaction is committed.  Open transactions
+        are tracked by ObservableSettings and are thus local to a
+        session when QL_ENABLE_SESSIONS is defined.  When the
+        thread-safe observer pattern is enabled, a transaction falls
+        back on deferring updates through ObservableSettings.
+
+        \code
+        {
+            ObservableTransaction transaction;
+            for (Size i=0; i<quotes.size(); ++i)
+                quotes[i]->setValue(values[i]);
+            transaction.commit();
+        }
+        \endcode
+
+        \warning an observer might be notified before all the
+                 observables it depends on are.  As for deferred
+                 updates, it is suggested that the update() method
+                 just raise a flag in order to trigger a later
+                 recalculation.
+
+        \ingroup patterns
+    */
+    class ObservableTransaction {
+      public:
+        ObservableTransaction();
+        /*! commits the transaction if commit() wasn't called.
+            Exceptions thrown by observers are swallowed; call
+            commit() explicitly to have them reported. */
+        ~ObservableTransaction();
+        ObservableTransaction(const ObservableTransaction&) = delete;
+        ObservableTransaction& operator=(const ObservableTransaction&) = delete;
+        //! closes the transaction and sends the collected notifications
+        void commit();
+      private:
+        bool committed_ = false;
+        #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        bool deferring_ = false;
+        #endif
+    };
+
+    inline ObservableTransaction::~ObservableTransaction() {
+        if (!committed_) {
+            try {
+                commit();
+            } catch (...) {}
+        }
+    }
+
+}
+
 #endif
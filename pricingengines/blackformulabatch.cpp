@@ -0,0 +1,315 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/comparison.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/blackformulabatch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace {
+
+        void checkBatchParameters(const Real* strike,
+                                  const Real* forward,
+                                  const Real* discount,
+                                  Size n) {
+            for (Size i=0; i<n; ++i) {
+                QL_REQUIRE(strike[i] >= 0.0,
+                           "strike (" << strike[i] << ") for option #"
+                           << i << " must be non-negative");
+                QL_REQUIRE(forward[i] > 0.0,
+                           "forward (" << forward[i] << ") for option #"
+                           << i << " must be positive");
+                QL_REQUIRE(discount[i] > 0.0,
+                           "discount (" << discount[i] << ") for option #"
+                           << i << " must be positive");
+            }
+        }
+
+        // Sets d1 and d2 to the signed Black d1 and d2.  The results
+        // for null strikes or standard deviations are not used; dummy
+        // values are substituted in the calculation, so that no
+        // branch is needed and no NaN is produced.
+        void signedD(const Option::Type* optionType,
+                     const Real* strike,
+                     const Real* forward,
+                     const Real* stdDev,
+                     Real* d1,
+                     Real* d2,
+                     Size n) {
+            for (Size i=0; i<n; ++i) {
+                auto sign = Real(optionType[i]);
+                Real k = strike[i] > 0.0 ? strike[i] : forward[i];
+                Real s = stdDev[i] > 0.0 ? stdDev[i] : Real(1.0);
+                Real d = std::log(forward[i]/k)/s + 0.5*s;
+                d1[i] = sign * d;
+                d2[i] = sign * (d - s);
+            }
+        }
+
+        // undiscounted intrinsic value, used for null strikes or
+        // standard deviations
+        Real intrinsicValue(Option::Type optionType,
+                            Real strike,
+                            Real forward) {
+            if (strike == 0.0)
+                return optionType == Option::Call ? forward : Real(0.0);
+            return std::max((forward-strike) * Integer(optionType),
+                            Real(0.0));
+        }
+
+    }
+
+    void blackFormulaBatch(const Option::Type* optionType,
+                           const Real* strike,
+                           const Real* forward,
+                           const Real* stdDev,
+                           const Real* discount,
+                           Real* value,
+                           Size n) {
+        checkBatchParameters(strike, forward, discount, n);
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(stdDev[i] >= 0.0,
+                       "stdDev (" << stdDev[i] << ") for option #"
+                       << i << " must be non-negative");
+
+        std::vector<Real> d1(n), nd1(n), nd2(n);
+        signedD(optionType, strike, forward, stdDev, d1.data(), nd2.data(), n);
+        CumulativeNormalDistribution phi;
+        phi.transform(d1.data(), nd1.data(), n);
+        phi.transform(nd2.data(), nd2.data(), n);
+
+        for (Size i=0; i<n; ++i) {
+            auto sign = Real(optionType[i]);
+            value[i] = discount[i] * sign *
+                (forward[i]*nd1[i] - strike[i]*nd2[i]);
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (stdDev[i] == 0.0 || strike[i] == 0.0)
+                value[i] = discount[i] *
+                    intrinsicValue(optionType[i], strike[i], forward[i]);
+        }
+    }
+
+    void blackFormulaGreeksBatch(const Option::Type* optionType,
+                                 const Real* strike,
+                                 const Real* forward,
+                                 const Real* stdDev,
+                                 const Real* discount,
+                                 const Real* spot,
+                                 const Time* maturity,
+                                 Real* value,
+                                 Real* delta,
+                                 Real* gamma,
+                                 Real* vega,
+                                 Real* theta,
+                                 Size n) {
+        checkBatchParameters(strike, forward, discount, n);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(stdDev[i] >= 0.0,
+                       "stdDev (" << stdDev[i] << ") for option #"
+                       << i << " must be non-negative");
+            QL_REQUIRE(spot[i] > 0.0,
+                       "spot (" << spot[i] << ") for option #"
+                       << i << " must be positive");
+            QL_REQUIRE(maturity[i] >= 0.0,
+                       "maturity (" << maturity[i] << ") for option #"
+                       << i << " must be non-negative");
+        }
+
+        std::vector<Real> d1(n), nd1(n), nd2(n), price(n);
+        signedD(optionType, strike, forward, stdDev, d1.data(), nd2.data(), n);
+        CumulativeNormalDistribution phi;
+        phi.transform(d1.data(), nd1.data(), n);
+        phi.transform(nd2.data(), nd2.data(), n);
+
+        // from now on, d1 holds the normal density at d1 times the
+        // forward, i.e., the undiscounted vega per unit of stdDev
+        const Real normalization = M_SQRT_2 * M_1_SQRTPI;
+        for (Size i=0; i<n; ++i) {
+            auto sign = Real(optionType[i]);
+            price[i] = discount[i] * sign *
+                (forward[i]*nd1[i] - strike[i]*nd2[i]);
+            nd1[i] *= sign;
+            d1[i] = forward[i] * normalization * std::exp(-0.5*d1[i]*d1[i]);
+        }
+
+        // null stdDev or strike: greeks of the intrinsic value
+        for (Size i=0; i<n; ++i) {
+            if (stdDev[i] == 0.0 || strike[i] == 0.0) {
+                Real intrinsic =
+                    intrinsicValue(optionType[i], strike[i], forward[i]);
+                price[i] = discount[i] * intrinsic;
+                nd1[i] = (intrinsic > 0.0 ? Real(optionType[i]) : 0.0);
+                d1[i] = 0.0;
+            }
+        }
+
+        if (value != nullptr)
+            std::copy(price.begin(), price.end(), value);
+
+        if (delta != nullptr) {
+            for (Size i=0; i<n; ++i)
+                delta[i] = discount[i] * nd1[i] * forward[i] / spot[i];
+        }
+
+        if (gamma != nullptr) {
+            for (Size i=0; i<n; ++i)
+                gamma[i] = (d1[i] == 0.0 ? Real(0.0) :
+                            discount[i] * d1[i]
+                            / (spot[i] * spot[i] * stdDev[i]));
+        }
+
+        if (vega != nullptr) {
+            for (Size i=0; i<n; ++i)
+                vega[i] = discount[i] * d1[i] * std::sqrt(maturity[i]);
+        }
+
+        if (theta != nullptr) {
+            // same as BlackCalculator::theta, using
+            // spot*delta = discount*nd1*forward and
+            // spot^2*gamma = discount*d1/stdDev
+            for (Size i=0; i<n; ++i) {
+                if (close(maturity[i], 0.0)) {
+                    theta[i] = 0.0;
+                } else {
+                    theta[i] = -(std::log(discount[i]) * price[i]
+                                 + std::log(forward[i]/spot[i])
+                                   * discount[i] * nd1[i] * forward[i]
+                                 + 0.5 * stdDev[i] * discount[i] * d1[i])
+                        / maturity[i];
+                }
+            }
+        }
+    }
+
+    void blackFormulaImpliedStdDevBatch(const Option::Type* optionType,
+                                        const Real* strike,
+                                        const Real* forward,
+                                        const Real* blackPrice,
+                                        const Real* discount,
+                                        Real* stdDev,
+                                        Size n,
+                                        const Real* guess,
+                                        Real accuracy,
+                                        Natural maxIterations) {
+        checkBatchParameters(strike, forward, discount, n);
+
+        // as in blackFormulaImpliedStdDev, solve for the
+        // out-of-the-money option, which is numerically more robust
+        std::vector<Option::Type> type(optionType, optionType+n);
+        std::vector<Real> target(n);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(blackPrice[i] >= 0.0,
+                       "option price (" << blackPrice[i] << ") for option #"
+                       << i << " must be non-negative");
+            Real otherOptionPrice = blackPrice[i]
+                - Integer(type[i]) * (forward[i]-strike[i])*discount[i];
+            QL_REQUIRE(otherOptionPrice >= 0.0,
+                       "negative " << Option::Type(-1*type[i]) <<
+                       " price (" << otherOptionPrice <<
+                       ") implied by put-call parity for option #" << i <<
+                       ". No solution exists for " << type[i] <<
+                       " strike " << strike[i] <<
+                       ", forward " << forward[i] <<
+                       ", price " << blackPrice[i] <<
+                       ", deflator " << discount[i]);
+            Real price = blackPrice[i];
+            if ((type[i] == Option::Put && strike[i] > forward[i]) ||
+                (type[i] == Option::Call && strike[i] < forward[i])) {
+                type[i] = Option::Type(-1*type[i]);
+                price = otherOptionPrice;
+            }
+            target[i] = price/discount[i];
+
+            if (guess != nullptr) {
+                QL_REQUIRE(guess[i] >= 0.0,
+                           "stdDev guess (" << guess[i] << ") for option #"
+                           << i << " must be non-negative");
+                stdDev[i] = guess[i];
+            } else {
+                stdDev[i] = blackFormulaImpliedStdDevApproximation(
+                    type[i], strike[i], forward[i], price, discount[i]);
+            }
+        }
+
+        // lockstep Newton iterations on the options not yet converged
+        const Real minStdDev = 0.0, maxStdDev = 24.0;
+        const Real normalization = M_SQRT_2 * M_1_SQRTPI;
+        CumulativeNormalDistribution phi;
+        std::vector<Size> active, fallback;
+        for (Size i=0; i<n; ++i) {
+            // degenerate cases are left to the scalar solver
+            if (strike[i] == 0.0 || stdDev[i] <= minStdDev ||
+                stdDev[i] >= maxStdDev)
+                fallback.push_back(i);
+            else
+                active.push_back(i);
+        }
+
+        std::vector<Real> d1(n), d2(n), nd1(n), nd2(n);
+        for (Natural iteration=0;
+             iteration<maxIterations && !active.empty(); ++iteration) {
+            const Size m = active.size();
+            for (Size k=0; k<m; ++k) {
+                Size i = active[k];
+                auto sign = Real(type[i]);
+                Real d = std::log(forward[i]/strike[i])/stdDev[i]
+                    + 0.5*stdDev[i];
+                d1[k] = sign * d;
+                d2[k] = sign * (d - stdDev[i]);
+            }
+            phi.transform(d1.data(), nd1.data(), m);
+            phi.transform(d2.data(), nd2.data(), m);
+
+            Size stillActive = 0;
+            for (Size k=0; k<m; ++k) {
+                Size i = active[k];
+                auto sign = Real(type[i]);
+                Real price = std::max(Real(0.0),
+                    sign * (forward[i]*nd1[k] - strike[i]*nd2[k]));
+                Real vega = forward[i] * normalization
+                    * std::exp(-0.5*d1[k]*d1[k]);
+                Real step = (price - target[i]) / vega;
+                Real next = stdDev[i] - step;
+                if (vega == 0.0 || !(next > minStdDev && next < maxStdDev)) {
+                    fallback.push_back(i);
+                } else {
+                    stdDev[i] = next;
+                    if (std::fabs(step) >= accuracy)
+                        active[stillActive++] = i;
+                }
+            }
+            active.resize(stillActive);
+        }
+
+        fallback.insert(fallback.end(), active.begin(), active.end());
+        for (Size i : fallback) {
+            stdDev[i] = blackFormulaImpliedStdDev(
+                optionType[i], strike[i], forward[i], blackPrice[i],
+                discount[i], 0.0,
+                guess != nullptr ? guess[i] : Null<Real>(),
+                accuracy, maxIterations);
+        }
+    }
+
+}
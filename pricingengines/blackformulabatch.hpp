@@ -0,0 +1,105 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blackformulabatch.hpp
+    \brief Black formula on batches of options
+*/
+
+#ifndef quantlib_blackformula_batch_hpp
+#define quantlib_blackformula_batch_hpp
+
+#include <ql/option.hpp>
+
+namespace QuantLib {
+
+    /*! Black 1976 formula for a batch of plain-vanilla options.
+
+        The inputs are given as arrays of n elements, one for each
+        option; value[i] is set to the value of the i-th option.  The
+        results are the same as those returned by blackFormula (with
+        null displacement) for each option; however, the calculation
+        is performed in separate passes over the whole batch, so that
+        the compiler can vectorize the loops and no per-option object
+        needs to be built.
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    void blackFormulaBatch(const Option::Type* optionType,
+                           const Real* strike,
+                           const Real* forward,
+                           const Real* stdDev,
+                           const Real* discount,
+                           Real* value,
+                           Size n);
+
+    /*! Black 1976 formula and greeks for a batch of plain-vanilla
+        options.
+
+        The greeks are the same returned by the corresponding methods
+        of BlackCalculator, i.e., delta(spot), gamma(spot),
+        vega(maturity) and theta(spot, maturity).  Any of the output
+        arrays can be null, in which case the corresponding quantity
+        is not calculated.
+
+        Unlike BlackCalculator, null standard deviations are allowed;
+        in that case the greeks are those of the intrinsic value.
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    void blackFormulaGreeksBatch(const Option::Type* optionType,
+                                 const Real* strike,
+                                 const Real* forward,
+                                 const Real* stdDev,
+                                 const Real* discount,
+                                 const Real* spot,
+                                 const Time* maturity,
+                                 Real* value,
+                                 Real* delta,
+                                 Real* gamma,
+                                 Real* vega,
+                                 Real* theta,
+                                 Size n);
+
+    /*! Black 1976 implied standard deviation for a batch of
+        plain-vanilla options, i.e. volatility*sqrt(timeToMaturity).
+
+        All the options are solved together: at each step, a Newton
+        iteration is performed on all the options which have not
+        converged yet.  The options for which Newton's method leaves
+        the [0, 24] bracket used by blackFormulaImpliedStdDev or
+        doesn't converge in the given number of iterations are then
+        solved one by one by blackFormulaImpliedStdDev.
+
+        If guess is null, the initial guesses are given by
+        blackFormulaImpliedStdDevApproximation.
+    */
+    void blackFormulaImpliedStdDevBatch(const Option::Type* optionType,
+                                        const Real* strike,
+                                        const Real* forward,
+                                        const Real* blackPrice,
+                                        const Real* discount,
+                                        Real* stdDev,
+                                        Size n,
+                                        const Real* guess = nullptr,
+                                        Real accuracy = 1.0e-6,
+                                        Natural maxIterations = 100);
+
+}
+
+#endif
@@ -65,6 +65,15 @@ namespace QuantLib {
         void calculate(Real requiredTolerance,
                        Size requiredSamples,
                        Size maxSamples) const;
+        //! number of threads used by the Monte Carlo model
+        /*! See MonteCarloModel for details; the path pricer and the
+            process used by the engine must be safe for concurrent use.
+            Threads are only spawned if OpenMP is enabled.
+        */
+        void setThreads(Size threads) {
+            QL_REQUIRE(threads > 0, "at least one thread is required");
+            threads_ = threads;
+        }
       protected:
         McSimulation(bool antitheticVariate,
                      bool controlVariate)
@@ -97,6 +106,7 @@ namespace QuantLib {
         
         mutable ext::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size threads_ = 1;
     };
 
 
@@ -186,13 +196,17 @@ namespace QuantLib {
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG));
+                           controlVariateValue, controlPG, threads_));
         } else {
             this->mcModel_ =
                 ext::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), S(),
-                           this->antitheticVariate_));
+                           this->antitheticVariate_,
+                           ext::shared_ptr<path_pricer_type>(),
+                           result_type(),
+                           ext::shared_ptr<path_generator_type>(),
+                           threads_));
         }
 
         if (requiredTolerance != Null<Real>()) {
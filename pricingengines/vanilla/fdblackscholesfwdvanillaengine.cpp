@@ -0,0 +1,168 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/integrals/discreteintegrals.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlocalvolfwdop.hpp>
+#include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesfwdvanillaengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/timegrid.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    FdBlackScholesFwdVanillaEngine::FdBlackScholesFwdVanillaEngine(
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+        Size tGrid,
+        Size xGrid)
+    : process_(std::move(process)), tGrid_(tGrid), xGrid_(xGrid) {
+        registerWith(process_);
+    }
+
+    void FdBlackScholesFwdVanillaEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        const Date exerciseDate = arguments_.exercise->lastDate();
+        const Time maturity = process_->time(exerciseDate);
+        QL_REQUIRE(maturity > 0.0, "expired option");
+
+        auto iter = std::find(maturities_.begin(), maturities_.end(), maturity);
+        if (iter == maturities_.end()) {
+            if (std::find(maturityDates_.begin(), maturityDates_.end(),
+                          exerciseDate) == maturityDates_.end())
+                maturityDates_.push_back(exerciseDate);
+            solve();
+            iter = std::find(maturities_.begin(), maturities_.end(), maturity);
+            QL_ENSURE(iter != maturities_.end(),
+                      "maturity " << maturity << " is not on the time grid");
+        }
+
+        const Array& p = densities_[iter - maturities_.begin()];
+        const Array x = mesher_->locations(0);
+
+        Array f(x.size());
+        for (Size i=0; i < f.size(); ++i)
+            f[i] = (*arguments_.payoff)(std::exp(x[i])) * p[i];
+
+        results_.value = process_->riskFreeRate()->discount(maturity)
+            * FdmMesherIntegral(mesher_, DiscreteSimpsonIntegral()).integrate(f);
+    }
+
+    void FdBlackScholesFwdVanillaEngine::solve() const {
+        // the results are stored only after a successful solve, so
+        // that a failure doesn't leave the engine inconsistent
+        maturities_.clear();
+        densities_.clear();
+        mesher_.reset();
+
+        std::vector<Time> maturities;
+        for (const auto& d : maturityDates_) {
+            const Time t = process_->time(d);
+            if (t > 0.0)
+                maturities.push_back(t);
+        }
+        std::sort(maturities.begin(), maturities.end());
+        maturities.erase(
+            std::unique(maturities.begin(), maturities.end(),
+                        static_cast<bool (*)(Real, Real)>(close_enough)),
+            maturities.end());
+
+        const TimeGrid grid(maturities.begin(), maturities.end(), tGrid_);
+
+        // the density leaks through the boundaries of the narrower
+        // grids used by the backward engines, hence the larger scale factor
+        const Real spot = process_->x0();
+        const ext::shared_ptr<FdmMesherComposite> mesher =
+            ext::make_shared<FdmMesherComposite>(
+                ext::make_shared<FdmBlackScholesMesher>(
+                    xGrid_, process_, maturities.back(), spot,
+                    Null<Real>(), Null<Real>(), 0.0001, 3.0,
+                    std::pair<Real, Real>(spot, 0.1)));
+
+        const ext::shared_ptr<LocalVolTermStructure> localVol =
+            process_->localVolatility().currentLink();
+        const ext::shared_ptr<YieldTermStructure> rTS =
+            process_->riskFreeRate().currentLink();
+        const ext::shared_ptr<YieldTermStructure> qTS =
+            process_->dividendYield().currentLink();
+
+        // start with the Gaussian density of a short first step
+        Time t = 0.5*grid[1];
+        const Volatility stdDev = localVol->localVol(0.0, spot, true)
+            * std::sqrt(t);
+        const Real xm = std::log(spot*qTS->discount(t)/rTS->discount(t))
+            - 0.5*stdDev*stdDev;
+
+        const Array x = mesher->locations(0);
+        const GaussianDistribution gaussianPDF(xm, stdDev);
+
+        const FdmMesherIntegral integral(mesher, DiscreteSimpsonIntegral());
+
+        Array p(x.size());
+        for (Size i=0; i < p.size(); ++i)
+            p[i] = gaussianPDF(x[i]);
+        p /= integral.integrate(p);
+
+        DouglasScheme evolver(0.5,
+            ext::make_shared<FdmLocalVolFwdOp>(
+                mesher, process_->stateVariable().currentLink(),
+                rTS, qTS, localVol));
+
+        std::vector<Array> densities;
+        densities.reserve(maturities.size());
+
+        for (Size i=1; i < grid.size(); ++i) {
+            evolver.setStep(grid[i] - t);
+            t = grid[i];
+            evolver.step(p, t);
+            p /= integral.integrate(p);
+
+            if (close_enough(t, maturities[densities.size()])) {
+                densities.push_back(p);
+                if (densities.size() == maturities.size())
+                    break;
+            }
+        }
+        QL_ENSURE(densities.size() == maturities.size(),
+                  "maturity " << maturities[densities.size()]
+                  << " is not on the time grid");
+
+        maturities_.swap(maturities);
+        densities_.swap(densities);
+        mesher_ = mesher;
+    }
+
+    void FdBlackScholesFwdVanillaEngine::update() {
+        maturities_.clear();
+        densities_.clear();
+        VanillaOption::engine::update();
+    }
+
+    void FdBlackScholesFwdVanillaEngine::enableMultipleMaturitiesCaching(
+                                        const std::vector<Date>& maturities) {
+        maturityDates_ = maturities;
+        maturities_.clear();
+        densities_.clear();
+    }
+}
@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdblackscholesfwdvanillaengine.hpp
+    \brief European options priced by integration against the local
+           volatility density of a single forward Fokker-Planck solve
+*/
+
+#ifndef quantlib_fd_black_scholes_fwd_vanilla_engine_hpp
+#define quantlib_fd_black_scholes_fwd_vanilla_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/math/array.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class FdmMesherComposite;
+    class GeneralizedBlackScholesProcess;
+
+    //! Finite-Differences forward (Fokker-Planck) vanilla option engine
+
+    /*! The risk neutral density of the log-spot is rolled forward
+        once under the local volatility of the process and stored at
+        every maturity seen so far. European options on any payoff and
+        maturity are then priced by integrating the payoff against the
+        stored density, hence a whole strike/maturity surface costs a
+        single PDE solve. Maturities which are not yet known trigger a
+        new solve, enableMultipleMaturitiesCaching announces them
+        beforehand.
+
+        \warning the local volatility of the process is used also if
+                 the process is given by an implied volatility surface.
+                 Only the option value is calculated.
+
+        \ingroup vanillaengines
+    */
+    class FdBlackScholesFwdVanillaEngine : public VanillaOption::engine {
+      public:
+        explicit FdBlackScholesFwdVanillaEngine(
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+            Size tGrid = 100,
+            Size xGrid = 400);
+
+        void calculate() const override;
+
+        void update() override;
+        void enableMultipleMaturitiesCaching(const std::vector<Date>& maturities);
+
+      private:
+        void solve() const;
+
+        const ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const Size tGrid_, xGrid_;
+
+        mutable std::vector<Date> maturityDates_;
+        mutable std::vector<Time> maturities_;
+        mutable std::vector<Array> densities_;
+        mutable ext::shared_ptr<FdmMesherComposite> mesher_;
+    };
+}
+
+#endif
@@ -20,20 +20,51 @@
 */
 
 #include <ql/exercise.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
 #include <ql/methods/finitedifferences/utilities/escroweddividendadjustment.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmescrowedloginnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+        bool strikeIndependentVolatility(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            bool localVol) {
+            if (localVol)
+                return true;
+
+            const ext::shared_ptr<BlackVolTermStructure> volTS =
+                process->blackVolatility().currentLink();
+            return ext::dynamic_pointer_cast<BlackConstantVol>(volTS) != nullptr
+                || ext::dynamic_pointer_cast<BlackVarianceCurve>(volTS) != nullptr;
+        }
+
+        bool sameDividends(const DividendSchedule& d1,
+                           const DividendSchedule& d2, Real spot) {
+            if (d1.size() != d2.size())
+                return false;
+            for (Size i=0; i < d1.size(); ++i)
+                if (d1[i]->date() != d2[i]->date()
+                    || d1[i]->amount(spot) != d2[i]->amount(spot))
+                    return false;
+            return true;
+        }
+    }
+
     FdBlackScholesVanillaEngine::FdBlackScholesVanillaEngine(
         ext::shared_ptr<GeneralizedBlackScholesProcess> process,
         Size tGrid,
@@ -70,6 +101,26 @@ namespace QuantLib {
 
 
     void FdBlackScholesVanillaEngine::calculate() const {
+        // cache lookup for precalculated results
+        for (auto& cachedArgs2result : cachedArgs2results_) {
+            if (cachedArgs2result.first.exercise->type() == arguments_.exercise->type() &&
+                cachedArgs2result.first.exercise->dates() == arguments_.exercise->dates() &&
+                sameDividends(cachedArgs2result.first.cashFlow,
+                              arguments_.cashFlow, process_->x0())) {
+                ext::shared_ptr<PlainVanillaPayoff> p1 =
+                    ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                            arguments_.payoff);
+                ext::shared_ptr<PlainVanillaPayoff> p2 =
+                    ext::dynamic_pointer_cast<PlainVanillaPayoff>(cachedArgs2result.first.payoff);
+
+                if ((p1 != nullptr) && p1->strike() == p2->strike() &&
+                    p1->optionType() == p2->optionType()) {
+                    results_ = cachedArgs2result.second;
+                    return;
+                }
+            }
+        }
+
         // 0. Cash dividend model
         const Date exerciseDate = arguments_.exercise->lastDate();
         const Time maturity = process_->time(exerciseDate);
@@ -117,11 +168,23 @@ namespace QuantLib {
         const ext::shared_ptr<StrikedTypePayoff> payoff =
             ext::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
 
+        const Real spot = process_->x0() + spotAdjustment;
+
+        const bool batched =
+            std::find(strikes_.begin(), strikes_.end(), payoff->strike())
+                != strikes_.end()
+            && ext::dynamic_pointer_cast<PlainVanillaPayoff>(payoff) != nullptr
+            && strikeIndependentVolatility(process_, localVol_);
+
+        // a batch is priced on a grid concentrated on the spot, so that
+        // its results don't depend on which of its options comes first
+        const Real gridStrike = batched ? spot : payoff->strike();
+
         const ext::shared_ptr<Fdm1dMesher> equityMesher =
             ext::make_shared<FdmBlackScholesMesher>(
-                    xGrid_, process_, maturity, payoff->strike(), 
+                    xGrid_, process_, maturity, gridStrike,
                     Null<Real>(), Null<Real>(), 0.0001, 1.5, 
-                    std::pair<Real, Real>(payoff->strike(), 0.1),
+                    std::pair<Real, Real>(gridStrike, 0.1),
                     dividendSchedule, quantoHelper_,
                     spotAdjustment);
         
@@ -129,30 +192,122 @@ namespace QuantLib {
             ext::make_shared<FdmMesherComposite>(equityMesher);
         
         // 2. Calculator
-        ext::shared_ptr<FdmInnerValueCalculator> calculator;
-        switch (cashDividendModel_) {
-          case Spot:
-              calculator = ext::make_shared<FdmLogInnerValue>(
-                  payoff, mesher, 0);
-            break;
-          case Escrowed:
-              calculator = ext::make_shared<FdmEscrowedLogInnerValueCalculator>(
-                  escrowedDivAdj, payoff, mesher, 0);
-            break;
-          default:
-              QL_FAIL("unknwon cash dividend model");
-        }
+        const auto innerValueCalculator =
+            [&](const ext::shared_ptr<StrikedTypePayoff>& p)
+                -> ext::shared_ptr<FdmInnerValueCalculator> {
+            switch (cashDividendModel_) {
+              case Spot:
+                return ext::make_shared<FdmLogInnerValue>(p, mesher, 0);
+              case Escrowed:
+                return ext::make_shared<FdmEscrowedLogInnerValueCalculator>(
+                    escrowedDivAdj, p, mesher, 0);
+              default:
+                QL_FAIL("unknwon cash dividend model");
+            }
+        };
+        const ext::shared_ptr<FdmInnerValueCalculator> calculator =
+            innerValueCalculator(payoff);
 
         // 3. Step conditions
-        const ext::shared_ptr<FdmStepConditionComposite> conditions = 
-            FdmStepConditionComposite::vanillaComposite(
-                dividendSchedule, arguments_.exercise, mesher, calculator,
+        const auto stepConditions =
+            [&](const ext::shared_ptr<FdmInnerValueCalculator>& c) {
+            return FdmStepConditionComposite::vanillaComposite(
+                dividendSchedule, arguments_.exercise, mesher, c,
                 process_->riskFreeRate()->referenceDate(),
                 process_->riskFreeRate()->dayCounter());
+        };
+        const ext::shared_ptr<FdmStepConditionComposite> conditions =
+            stepConditions(calculator);
 
         // 4. Boundary conditions
         const FdmBoundaryConditionSet boundaries;
 
+        if (batched) {
+            // 5. Batched solver, all strikes share mesher and operator
+            std::vector<Real> strikes;
+            for (Real strike : strikes_)
+                if (std::find(strikes.begin(), strikes.end(), strike)
+                        == strikes.end())
+                    strikes.push_back(strike);
+
+            const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+            const Time thetaTime = 0.99 * std::min(1.0 / 365.0,
+                conditions->stoppingTimes().empty() ?
+                    maturity : conditions->stoppingTimes().front());
+
+            std::vector<Array> values(strikes.size(), Array(layout->size()));
+            std::vector<ext::shared_ptr<FdmSnapshotCondition> >
+                thetaConditions(strikes.size());
+            std::vector<ext::shared_ptr<FdmStepConditionComposite> >
+                batchConditions(strikes.size());
+
+            for (Size i=0; i < strikes.size(); ++i) {
+                const ext::shared_ptr<FdmInnerValueCalculator> c =
+                    innerValueCalculator(ext::make_shared<PlainVanillaPayoff>(
+                        payoff->optionType(), strikes[i]));
+
+                thetaConditions[i] =
+                    ext::make_shared<FdmSnapshotCondition>(thetaTime);
+                batchConditions[i] = FdmStepConditionComposite::joinConditions(
+                    thetaConditions[i], stepConditions(c));
+
+                const FdmLinearOpIterator endIter = layout->end();
+                for (FdmLinearOpIterator iter = layout->begin();
+                     iter != endIter; ++iter)
+                    values[i][iter.index()] = c->avgInnerValue(iter, maturity);
+            }
+
+            const ext::shared_ptr<FdmBlackScholesOp> op(
+                ext::make_shared<FdmBlackScholesOp>(
+                    mesher, process_, gridStrike,
+                    localVol_, illegalLocalVolOverwrite_, 0, quantoHelper_));
+
+            FdmBackwardSolver(op, boundaries,
+                              ext::shared_ptr<FdmStepConditionComposite>(),
+                              schemeDesc_)
+                .rollback(values, batchConditions, maturity, 0.0,
+                          tGrid_, dampingSteps_);
+
+            // 6. Results
+            const Array x = mesher->locations(0);
+            const Real logSpot = std::log(spot);
+
+            cachedArgs2results_.resize(strikes.size());
+            for (Size i=0; i < strikes.size(); ++i) {
+                cachedArgs2results_[i].first.exercise = arguments_.exercise;
+                cachedArgs2results_[i].first.payoff =
+                    ext::make_shared<PlainVanillaPayoff>(
+                        payoff->optionType(), strikes[i]);
+                cachedArgs2results_[i].first.cashFlow = arguments_.cashFlow;
+
+                DividendVanillaOption::results&
+                                    results = cachedArgs2results_[i].second;
+                results.reset();
+
+                const MonotonicCubicNaturalSpline interpolation(
+                    x.begin(), x.end(), values[i].begin());
+                const Real d1 = interpolation.derivative(logSpot);
+
+                results.value = interpolation(logSpot);
+                results.delta = d1/spot;
+                results.gamma =
+                    (interpolation.secondDerivative(logSpot) - d1)/(spot*spot);
+
+                if (batchConditions[i]->stoppingTimes().front() == 0.0)
+                    results.theta = Null<Real>();
+                else {
+                    const Array& thetaValues = thetaConditions[i]->getValues();
+                    results.theta = (MonotonicCubicNaturalSpline(
+                        x.begin(), x.end(), thetaValues.begin())(logSpot)
+                        - results.value) / thetaTime;
+                }
+            }
+            results_ = cachedArgs2results_[
+                std::find(strikes.begin(), strikes.end(), payoff->strike())
+                    - strikes.begin()].second;
+            return;
+        }
+
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
                                      maturity, tGrid_, dampingSteps_ };
@@ -164,14 +319,23 @@ namespace QuantLib {
                 localVol_, illegalLocalVolOverwrite_,
                 Handle<FdmQuantoHelper>(quantoHelper_)));
 
-        const Real spot = process_->x0() + spotAdjustment;
-
         results_.value = solver->valueAt(spot);
         results_.delta = solver->deltaAt(spot);
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
     }
 
+    void FdBlackScholesVanillaEngine::update() {
+        cachedArgs2results_.clear();
+        DividendVanillaOption::engine::update();
+    }
+
+    void FdBlackScholesVanillaEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedArgs2results_.clear();
+    }
+
     MakeFdBlackScholesVanillaEngine::MakeFdBlackScholesVanillaEngine(
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)),
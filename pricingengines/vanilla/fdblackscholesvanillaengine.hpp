@@ -69,6 +69,26 @@ namespace QuantLib {
                                     CashDividendModel cashDividendModel = Spot);
 
         void calculate() const override;
+        void update() override;
+
+        /*! multiple strikes caching engine: options with the
+            same exercise, dividends and option type and with one of
+            the given strikes are priced together in a single rollback.
+            The following options are served from the cache.  The
+            grid is concentrated on the spot rather than on the
+            strike, so that the results don't depend on the order in
+            which the options are priced; they differ from those of
+            the engine without caching within the discretization
+            error.
+
+            \warning batching requires a plain-vanilla payoff and a
+                     strike-independent volatility, i.e. either local
+                     volatility, a BlackConstantVol or a
+                     BlackVarianceCurve; otherwise, or if their strike
+                     is not among the given ones, the options are
+                     priced one by one.
+        */
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
 
       private:
         const ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
@@ -78,6 +98,11 @@ namespace QuantLib {
         const Real illegalLocalVolOverwrite_;
         const ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
         const CashDividendModel cashDividendModel_;
+
+        std::vector<Real> strikes_;
+        mutable std::vector<std::pair<DividendVanillaOption::arguments,
+                                      DividendVanillaOption::results> >
+                                                            cachedArgs2results_;
     };
 
 
@@ -62,6 +62,16 @@ namespace QuantLib {
         return retVal;
     }
 
+    void BatesProcess::evolveBatch(Time t0,
+                                   const Real* x0,
+                                   Time dt,
+                                   const Real* dw,
+                                   Real* x,
+                                   Size n) const {
+        // jumps are added path by path in evolve()
+        StochasticProcess::evolveBatch(t0, x0, dt, dw, x, n);
+    }
+
     Size BatesProcess::factors() const {
         return HestonProcess::factors() + 2;
     }
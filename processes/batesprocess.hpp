@@ -60,6 +60,12 @@ namespace QuantLib {
         Size factors() const override;
         Array drift(Time t, const Array& x) const override;
         Array evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
+        void evolveBatch(Time t0,
+                         const Real* x0,
+                         Time dt,
+                         const Real* dw,
+                         Real* x,
+                         Size n) const override;
 
         Real lambda() const;
         Real nu()     const;
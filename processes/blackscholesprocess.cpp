@@ -146,6 +146,30 @@ namespace QuantLib {
                                  stdDeviation(t0, x0, dt) * dw);
     }
 
+    void GeneralizedBlackScholesProcess::evolveBatch(Time t0,
+                                                     const Real* x0,
+                                                     Time dt,
+                                                     const Real* dw,
+                                                     Real* x,
+                                                     Size n) const {
+        localVolatility(); // trigger update
+        if (n > 0 && isStrikeIndependent_ && !forceDiscretization_) {
+            // exact value for curves; see evolve()
+            Real var = variance(t0, x0[0], dt);
+            Real drift = (riskFreeRate_->forwardRate(t0, t0 + dt, Continuous,
+                                                     NoFrequency, true).rate() -
+                          dividendYield_->forwardRate(t0, t0 + dt, Continuous,
+                                                      NoFrequency, true).rate()) *
+                             dt -
+                         0.5 * var;
+            Real stdDev = std::sqrt(var);
+            for (Size i=0; i<n; ++i)
+                x[i] = x0[i] * std::exp(stdDev * dw[i] + drift);
+        } else {
+            StochasticProcess1D::evolveBatch(t0, x0, dt, dw, x, n);
+        }
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
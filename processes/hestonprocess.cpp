@@ -396,50 +396,19 @@ namespace QuantLib {
     Array HestonProcess::evolve(Time t0, const Array& x0,
                                 Time dt, const Array& dw) const {
         Array retVal(2);
-        Real vol, vol2, mu, nu, dy;
+        Real vol, mu, dy;
 
         const Real sdt = std::sqrt(dt);
         const Real sqrhov = std::sqrt(1.0 - rho_*rho_);
 
         switch (discretization_) {
-          // For the definition of PartialTruncation, FullTruncation
-          // and Reflection  see Lord, R., R. Koekkoek and D. van Dijk (2006),
-          // "A Comparison of biased simulation schemes for
-          //  stochastic volatility models",
-          // Working Paper, Tinbergen Institute
           case PartialTruncation:
-            vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : Real(0.0);
-            vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate()
-                    - 0.5 * vol * vol;
-            nu = kappa_*(theta_ - x0[1]);
-
-            retVal[0] = x0[0] * std::exp(mu*dt+vol*dw[0]*sdt);
-            retVal[1] = x0[1] + nu*dt + vol2*sdt*(rho_*dw[0] + sqrhov*dw[1]);
-            break;
           case FullTruncation:
-            vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : Real(0.0);
-            vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate()
-                    - 0.5 * vol * vol;
-            nu = kappa_*(theta_ - vol*vol);
-
-            retVal[0] = x0[0] * std::exp(mu*dt+vol*dw[0]*sdt);
-            retVal[1] = x0[1] + nu*dt + vol2*sdt*(rho_*dw[0] + sqrhov*dw[1]);
-            break;
           case Reflection:
-            vol = std::sqrt(std::fabs(x0[1]));
-            vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate()
-                    - 0.5 * vol*vol;
-            nu = kappa_*(theta_ - vol*vol);
-
-            retVal[0] = x0[0]*std::exp(mu*dt+vol*dw[0]*sdt);
-            retVal[1] = vol*vol
-                        +nu*dt + vol2*sdt*(rho_*dw[0] + sqrhov*dw[1]);
+          case QuadraticExponential:
+          case QuadraticExponentialMartingale:
+            // a single path stored by component
+            evolvePaths(t0, x0.begin(), dt, dw.begin(), retVal.begin(), 1);
             break;
           case NonCentralChiSquareVariance:
             // use Alan Lewis trick to decorrelate the equity and the variance
@@ -458,62 +427,6 @@ namespace QuantLib {
 
             retVal[0] = x0[0]*std::exp(dy + rho_/sigma_*(retVal[1]-x0[1]));
             break;
-          case QuadraticExponential:
-          case QuadraticExponentialMartingale:
-          {
-            // for details of the quadratic exponential discretization scheme
-            // see Leif Andersen,
-            // Efficient Simulation of the Heston Stochastic Volatility Model
-            const Real ex = std::exp(-kappa_*dt);
-
-            const Real m  =  theta_+(x0[1]-theta_)*ex;
-            const Real s2 =  x0[1]*sigma_*sigma_*ex/kappa_*(1-ex)
-                           + theta_*sigma_*sigma_/(2*kappa_)*(1-ex)*(1-ex);
-            const Real psi = s2/(m*m);
-
-            const Real g1 =  0.5;
-            const Real g2 =  0.5;
-                  Real k0 = -rho_*kappa_*theta_*dt/sigma_;
-            const Real k1 =  g1*dt*(kappa_*rho_/sigma_-0.5)-rho_/sigma_;
-            const Real k2 =  g2*dt*(kappa_*rho_/sigma_-0.5)+rho_/sigma_;
-            const Real k3 =  g1*dt*(1-rho_*rho_);
-            const Real k4 =  g2*dt*(1-rho_*rho_);
-            const Real A  =  k2+0.5*k4;
-
-            if (psi < 1.5) {
-                const Real b2 = 2/psi-1+std::sqrt(2/psi*(2/psi-1));
-                const Real b  = std::sqrt(b2);
-                const Real a  = m/(1+b2);
-
-                if (discretization_ == QuadraticExponentialMartingale) {
-                    // martingale correction
-                    QL_REQUIRE(A < 1/(2*a), "illegal value");
-                    k0 = -A*b2*a/(1-2*A*a)+0.5*std::log(1-2*A*a)
-                         -(k1+0.5*k3)*x0[1];
-                }
-                retVal[1] = a*(b+dw[1])*(b+dw[1]);
-            }
-            else {
-                const Real p = (psi-1)/(psi+1);
-                const Real beta = (1-p)/m;
-
-                const Real u = CumulativeNormalDistribution()(dw[1]);
-
-                if (discretization_ == QuadraticExponentialMartingale) {
-                    // martingale correction
-                    QL_REQUIRE(A < beta, "illegal value");
-                    k0 = -std::log(p+beta*(1-p)/(beta-A))-(k1+0.5*k3)*x0[1];
-                }
-                retVal[1] = ((u <= p) ? Real(0.0) : std::log((1-p)/(1-u))/beta);
-            }
-
-            mu =   riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                 - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate();
-
-            retVal[0] = x0[0]*std::exp(mu*dt + k0 + k1*x0[1] + k2*retVal[1]
-                                       +std::sqrt(k3*x0[1]+k4*retVal[1])*dw[0]);
-          }
-          break;
           case BroadieKayaExactSchemeLobatto:
           case BroadieKayaExactSchemeLaguerre:
           case BroadieKayaExactSchemeTrapezoidal:
@@ -549,6 +462,151 @@ namespace QuantLib {
         return retVal;
     }
 
+    void HestonProcess::evolveBatch(Time t0,
+                                    const Real* x0,
+                                    Time dt,
+                                    const Real* dw,
+                                    Real* x,
+                                    Size n) const {
+        switch (discretization_) {
+          case PartialTruncation:
+          case FullTruncation:
+          case Reflection:
+          case QuadraticExponential:
+          case QuadraticExponentialMartingale:
+            evolvePaths(t0, x0, dt, dw, x, n);
+            break;
+          default:
+            StochasticProcess::evolveBatch(t0, x0, dt, dw, x, n);
+        }
+    }
+
+    void HestonProcess::evolvePaths(Time t0,
+                                    const Real* x0,
+                                    Time dt,
+                                    const Real* dw,
+                                    Real* x,
+                                    Size n) const {
+        // state variables and increments are stored by component
+        const Real* s0 = x0;
+        const Real* v0 = x0 + n;
+        const Real* dw0 = dw;
+        const Real* dw1 = dw + n;
+        Real* s = x;
+        Real* v = x + n;
+
+        Real vol, vol2, mu, nu;
+
+        const Real sdt = std::sqrt(dt);
+        const Real sqrhov = std::sqrt(1.0 - rho_*rho_);
+        // the rates don't depend on the path
+        const Real rq =
+              riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
+            - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate();
+
+        switch (discretization_) {
+          // For the definition of PartialTruncation, FullTruncation
+          // and Reflection  see Lord, R., R. Koekkoek and D. van Dijk (2006),
+          // "A Comparison of biased simulation schemes for
+          //  stochastic volatility models",
+          // Working Paper, Tinbergen Institute
+          case PartialTruncation:
+            for (Size i=0; i<n; ++i) {
+                vol = (v0[i] > 0.0) ? std::sqrt(v0[i]) : Real(0.0);
+                vol2 = sigma_ * vol;
+                mu = rq - 0.5 * vol * vol;
+                nu = kappa_*(theta_ - v0[i]);
+
+                s[i] = s0[i] * std::exp(mu*dt+vol*dw0[i]*sdt);
+                v[i] = v0[i] + nu*dt + vol2*sdt*(rho_*dw0[i] + sqrhov*dw1[i]);
+            }
+            break;
+          case FullTruncation:
+            for (Size i=0; i<n; ++i) {
+                vol = (v0[i] > 0.0) ? std::sqrt(v0[i]) : Real(0.0);
+                vol2 = sigma_ * vol;
+                mu = rq - 0.5 * vol * vol;
+                nu = kappa_*(theta_ - vol*vol);
+
+                s[i] = s0[i] * std::exp(mu*dt+vol*dw0[i]*sdt);
+                v[i] = v0[i] + nu*dt + vol2*sdt*(rho_*dw0[i] + sqrhov*dw1[i]);
+            }
+            break;
+          case Reflection:
+            for (Size i=0; i<n; ++i) {
+                vol = std::sqrt(std::fabs(v0[i]));
+                vol2 = sigma_ * vol;
+                mu = rq - 0.5 * vol*vol;
+                nu = kappa_*(theta_ - vol*vol);
+
+                s[i] = s0[i]*std::exp(mu*dt+vol*dw0[i]*sdt);
+                v[i] = vol*vol
+                       +nu*dt + vol2*sdt*(rho_*dw0[i] + sqrhov*dw1[i]);
+            }
+            break;
+          case QuadraticExponential:
+          case QuadraticExponentialMartingale:
+          {
+            // for details of the quadratic exponential discretization scheme
+            // see Leif Andersen,
+            // Efficient Simulation of the Heston Stochastic Volatility Model
+            const Real ex = std::exp(-kappa_*dt);
+
+            const Real g1 =  0.5;
+            const Real g2 =  0.5;
+            const Real k1 =  g1*dt*(kappa_*rho_/sigma_-0.5)-rho_/sigma_;
+            const Real k2 =  g2*dt*(kappa_*rho_/sigma_-0.5)+rho_/sigma_;
+            const Real k3 =  g1*dt*(1-rho_*rho_);
+            const Real k4 =  g2*dt*(1-rho_*rho_);
+            const Real A  =  k2+0.5*k4;
+
+            const CumulativeNormalDistribution cnd;
+
+            for (Size i=0; i<n; ++i) {
+                const Real m  =  theta_+(v0[i]-theta_)*ex;
+                const Real s2 =  v0[i]*sigma_*sigma_*ex/kappa_*(1-ex)
+                               + theta_*sigma_*sigma_/(2*kappa_)*(1-ex)*(1-ex);
+                const Real psi = s2/(m*m);
+
+                Real k0 = -rho_*kappa_*theta_*dt/sigma_;
+
+                if (psi < 1.5) {
+                    const Real b2 = 2/psi-1+std::sqrt(2/psi*(2/psi-1));
+                    const Real b  = std::sqrt(b2);
+                    const Real a  = m/(1+b2);
+
+                    if (discretization_ == QuadraticExponentialMartingale) {
+                        // martingale correction
+                        QL_REQUIRE(A < 1/(2*a), "illegal value");
+                        k0 = -A*b2*a/(1-2*A*a)+0.5*std::log(1-2*A*a)
+                             -(k1+0.5*k3)*v0[i];
+                    }
+                    v[i] = a*(b+dw1[i])*(b+dw1[i]);
+                }
+                else {
+                    const Real p = (psi-1)/(psi+1);
+                    const Real beta = (1-p)/m;
+
+                    const Real u = cnd(dw1[i]);
+
+                    if (discretization_ == QuadraticExponentialMartingale) {
+                        // martingale correction
+                        QL_REQUIRE(A < beta, "illegal value");
+                        k0 = -std::log(p+beta*(1-p)/(beta-A))-(k1+0.5*k3)*v0[i];
+                    }
+                    v[i] = ((u <= p) ? Real(0.0) : std::log((1-p)/(1-u))/beta);
+                }
+
+                s[i] = s0[i]*std::exp(rq*dt + k0 + k1*v0[i] + k2*v[i]
+                                      +std::sqrt(k3*v0[i]+k4*v[i])*dw0[i]);
+            }
+          }
+          break;
+          default:
+            QL_FAIL("unknown discretization schema");
+        }
+    }
+
     const Handle<Quote>& HestonProcess::s0() const {
         return s0_;
     }
@@ -73,6 +73,15 @@ namespace QuantLib {
         Matrix diffusion(Time t, const Array& x) const override;
         Array apply(const Array& x0, const Array& dx) const override;
         Array evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
+        /*! for the truncation, reflection and quadratic-exponential
+            schemes, the terms not depending on the path are only
+            computed once for the whole batch. */
+        void evolveBatch(Time t0,
+                         const Real* x0,
+                         Time dt,
+                         const Real* dw,
+                         Real* x,
+                         Size n) const override;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
@@ -92,6 +101,12 @@ namespace QuantLib {
 
       private:
         Real varianceDistribution(Real v, Real dw, Time dt) const;
+        void evolvePaths(Time t0,
+                         const Real* x0,
+                         Time dt,
+                         const Real* dw,
+                         Real* x,
+                         Size n) const;
 
         Handle<YieldTermStructure> riskFreeRate_, dividendYield_;
         Handle<Quote> s0_;
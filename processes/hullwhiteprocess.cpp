@@ -62,6 +62,25 @@ namespace QuantLib {
         return process_->variance(t0, x0, dt);
     }
 
+    void HullWhiteProcess::evolveBatch(Time t0,
+                                       const Real* x0,
+                                       Time dt,
+                                       const Real* dw,
+                                       Real* x,
+                                       Size n) const {
+        if (n == 0)
+            return;
+        // same terms as expectation() and stdDeviation()
+        const Real level = process_->level();
+        const Real decay = std::exp(-a_*dt);
+        const Real alpha0 = alpha(t0)*decay;
+        const Real alpha1 = alpha(t0 + dt);
+        const Real stdDev = stdDeviation(t0, x0[0], dt);
+        for (Size i=0; i<n; ++i)
+            x[i] = (level + (x0[i] - level) * decay + alpha1 - alpha0)
+                 + stdDev * dw[i];
+    }
+
     Real HullWhiteProcess::alpha(Time t) const {
         Real alfa = a_ > QL_EPSILON ?
                     Real((sigma_/a_)*(1 - std::exp(-a_*t))) :
@@ -45,6 +45,16 @@ namespace QuantLib {
         Real expectation(Time t0, Real x0, Time dt) const override;
         Real stdDeviation(Time t0, Real x0, Time dt) const override;
         Real variance(Time t0, Real x0, Time dt) const override;
+        /*! the expectation is affine in the state variable and the
+            standard deviation doesn't depend on it; their
+            coefficients are only computed once for the whole batch.
+        */
+        void evolveBatch(Time t0,
+                         const Real* x0,
+                         Time dt,
+                         const Real* dw,
+                         Real* x,
+                         Size n) const override;
 
         Real a() const;
         Real sigma() const;
@@ -56,6 +56,25 @@ namespace QuantLib {
         return apply(expectation(t0,x0,dt), stdDeviation(t0,x0,dt)*dw);
     }
 
+    void StochasticProcess::evolveBatch(Time t0,
+                                        const Real* x0,
+                                        Time dt,
+                                        const Real* dw,
+                                        Real* x,
+                                        Size n) const {
+        const Size m = size(), f = factors();
+        Array y0(m), dwi(f);
+        for (Size i=0; i<n; ++i) {
+            for (Size j=0; j<m; ++j)
+                y0[j] = x0[j*n+i];
+            for (Size j=0; j<f; ++j)
+                dwi[j] = dw[j*n+i];
+            Array y = evolve(t0, y0, dt, dwi);
+            for (Size j=0; j<m; ++j)
+                x[j*n+i] = y[j];
+        }
+    }
+
     Array StochasticProcess::apply(const Array& x0,
                                    const Array& dx) const {
         return x0 + dx;
@@ -96,4 +115,14 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess1D::evolveBatch(Time t0,
+                                          const Real* x0,
+                                          Time dt,
+                                          const Real* dw,
+                                          Real* x,
+                                          Size n) const {
+        for (Size i=0; i<n; ++i)
+            x[i] = evolve(t0, x0[i], dt, dw[i]);
+    }
+
 }
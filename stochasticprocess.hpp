@@ -124,6 +124,22 @@ namespace QuantLib {
                              const Array& x0,
                              Time dt,
                              const Array& dw) const;
+        /*! evolves a batch of \f$ n \f$ paths over a time interval
+            \f$ \Delta t \f$. The state variables and the Brownian
+            increments are stored by component, i.e., the \f$ j
+            \f$-th component of the \f$ i \f$-th path is found at
+            position \f$ jn+i \f$ of the \c x0, \c dw and \c x
+            arrays; \c x must not overlap \c x0. By default, it
+            calls evolve() for each path. It can be overridden in
+            derived classes which can compute the path-independent
+            terms only once.
+        */
+        virtual void evolveBatch(Time t0,
+                                 const Real* x0,
+                                 Time dt,
+                                 const Real* dw,
+                                 Real* x,
+                                 Size n) const;
         /*! applies a change to the asset value. By default, it
             returns \f$ \mathrm{x} + \Delta \mathrm{x} \f$.
         */
@@ -222,6 +238,15 @@ namespace QuantLib {
         */
         virtual Real apply(Real x0, Real dx) const;
         //@}
+        /*! evolves a batch of \f$ n \f$ paths; by default, it calls
+            evolve() for each path.
+        */
+        void evolveBatch(Time t0,
+                         const Real* x0,
+                         Time dt,
+                         const Real* dw,
+                         Real* x,
+                         Size n) const override;
       protected:
         StochasticProcess1D() = default;
         explicit StochasticProcess1D(ext::shared_ptr<discretization>);
@@ -30,6 +30,7 @@
 #include <ql/termstructures/bootstraphelper.hpp>
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -71,9 +72,40 @@ namespace detail {
         return result;
     }
 
+    //! records whether a bootstrap helper notified a change
+    class BootstrapHelperMonitor : public Observer {
+      public:
+        explicit BootstrapHelperMonitor(const ext::shared_ptr<Observable>& h)
+        : helper(h.get()) {
+            registerWith(h);
+        }
+        void update() override { changed = true; }
+        const Observable* helper;
+        bool changed = true;
+    };
+
+    // curves with jumps are notified by their jump quotes as well
+    template <class Curve>
+    auto hasJumps(const Curve* ts, int) -> decltype(ts->jumpDates().empty()) {
+        return !ts->jumpDates().empty();
+    }
+
+    template <class Curve>
+    bool hasJumps(const Curve*, ...) {
+        return false;
+    }
+
 }
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! When the interpolation is local and each helper only depends
+        on the curve up to its pillar, a change in a helper can't
+        affect the nodes at the earlier pillars.  In that case, the
+        bootstrapper keeps track of the helpers that notified a change
+        since the last successful bootstrap and only solves for the
+        pillars from the first of them onwards, using the previous
+        curve as a guess.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
@@ -102,6 +134,22 @@ namespace detail {
                            Size dontThrowSteps = 10);
         void setup(Curve* ts);
         void calculate() const;
+        /*! Returns the derivatives of the curve nodes at the pillars
+            (i.e., the curve data from the second point onwards) with
+            respect to the quotes of the alive helpers, sorted by
+            pillar date.  Element \f$ (i,j) \f$ is the derivative of
+            the \f$ i \f$-th node with respect to the \f$ j \f$-th
+            quote.
+
+            By the implicit function theorem, the result is the
+            inverse of the matrix of derivatives of the helper quotes
+            implied by the curve with respect to its nodes; the latter
+            only requires repricing the helpers on the bootstrapped
+            curve, which is much cheaper than bootstrapping it again
+            for each bumped quote.  The matrix is calculated upon
+            request and cached until the next bootstrap.
+        */
+        const Matrix& jacobian() const;
       private:
         void initialize() const;
         Real accuracy_;
@@ -119,6 +167,8 @@ namespace detail {
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<ext::shared_ptr<BootstrapError<Curve> > > errors_;
+        mutable std::vector<ext::shared_ptr<detail::BootstrapHelperMonitor> > monitors_;
+        mutable Matrix jacobian_;
     };
 
 
@@ -157,6 +207,30 @@ namespace detail {
         // ensure helpers are sorted
         std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
                   detail::BootstrapHelperSorter());
+        // monitor helpers in pillar order.  Moving curves sort their
+        // helpers at each initialization, and relative pillars might
+        // overtake fixed ones; in that case, the monitors are
+        // rearranged to follow their helpers.
+        bool sameOrder = (monitors_.size() == n_);
+        for (Size j=0; j<n_ && sameOrder; ++j)
+            sameOrder = (monitors_[j]->helper == ts_->instruments_[j].get());
+        if (!sameOrder) {
+            std::vector<ext::shared_ptr<detail::BootstrapHelperMonitor> >
+                monitors(n_);
+            for (Size j=0; j<n_; ++j) {
+                for (const auto& monitor : monitors_) {
+                    if (monitor->helper == ts_->instruments_[j].get()) {
+                        monitors[j] = monitor;
+                        break;
+                    }
+                }
+                if (!monitors[j])
+                    monitors[j] =
+                        ext::make_shared<detail::BootstrapHelperMonitor>(
+                                                     ts_->instruments_[j]);
+            }
+            monitors_.swap(monitors);
+        }
         // skip expired helpers
         Date firstDate = Traits::initialDate(ts_);
         QL_REQUIRE(ts_->instruments_[n_-1]->pillarDate()>firstDate,
@@ -233,8 +307,26 @@ namespace detail {
         // with evaluation date change.
         // anyway it makes little sense to use date relative helpers with a
         // non-moving curve if the evaluation date changes
-        if (!initialized_ || ts_->moving_)
+        bool incremental = validCurve_ && !detail::hasJumps(ts_, 0);
+        if (!initialized_ || ts_->moving_) {
+            std::vector<Date> previousDates = ts_->dates_;
             initialize();
+            incremental = incremental && ts_->dates_ == previousDates;
+        }
+        incremental = incremental && !loopRequired_;
+
+        jacobian_ = Matrix();
+
+        // first pillar to be solved for; if no helper changed, the
+        // notification came from elsewhere and we start afresh
+        Size firstPillar = 1;
+        if (incremental) {
+            while (firstPillar <= alive_ &&
+                   !monitors_[firstAliveHelper_+firstPillar-1]->changed)
+                ++firstPillar;
+            if (firstPillar > alive_)
+                firstPillar = 1;
+        }
 
         // setup helpers
         for (Size j=firstAliveHelper_; j<n_; ++j) {
@@ -248,7 +340,8 @@ namespace detail {
             // don't try this at home!
             // This call creates helpers, and removes "const".
             // There is a significant interaction with observability.
-            helper->setTermStructure(const_cast<Curve*>(ts_));
+            if (j+1 >= firstAliveHelper_+firstPillar)
+                helper->setTermStructure(const_cast<Curve*>(ts_));
         }
 
         const std::vector<Time>& times = ts_->times_;
@@ -268,7 +361,7 @@ namespace detail {
             std::vector<Real> maxValues(alive_+1, Null<Real>());
             std::vector<Size> attempts(alive_+1, 1);
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 // shorter aliases for readability and to avoid duplication
                 Real& min = minValues[i];
@@ -383,6 +476,52 @@ namespace detail {
             validData = true;
         }
         validCurve_ = true;
+        for (Size j=0; j<n_; ++j)
+            monitors_[j]->changed = false;
+    }
+
+    template <class Curve>
+    const Matrix& IterativeBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped");
+        if (!jacobian_.empty())
+            return jacobian_;
+
+        // helpers at unchanged pillars might have been skipped by the
+        // last bootstrap and set up on a different curve since
+        for (Size j=firstAliveHelper_; j<n_; ++j)
+            ts_->instruments_[j]->setTermStructure(const_cast<Curve*>(ts_));
+
+        std::vector<Real>& data = ts_->data_;
+        // derivatives of the quote errors with respect to the nodes.
+        // When the bootstrap didn't need to loop, each helper only
+        // depends on the nodes up to its own pillar and the matrix
+        // is lower triangular.
+        Matrix errorDerivatives(alive_, alive_, 0.0);
+        for (Size j=1; j<=alive_; ++j) {
+            Real value = data[j];
+            Real h = 1.0e-6 * std::max(std::fabs(value), Real(1.0));
+            Size first = loopRequired_ ? 1 : j;
+
+            Traits::updateGuess(data, value + h, j);
+            ts_->interpolation_.update();
+            for (Size i=first; i<=alive_; ++i)
+                errorDerivatives[i-1][j-1] = errors_[i]->helper()->quoteError();
+
+            Traits::updateGuess(data, value - h, j);
+            ts_->interpolation_.update();
+            for (Size i=first; i<=alive_; ++i) {
+                errorDerivatives[i-1][j-1] -= errors_[i]->helper()->quoteError();
+                errorDerivatives[i-1][j-1] /= 2.0*h;
+            }
+
+            Traits::updateGuess(data, value, j);
+        }
+        ts_->interpolation_.update();
+
+        // the quote error is the quote minus the implied quote, so
+        // the derivatives of the implied quotes are their opposites
+        jacobian_ = inverse(-1.0 * errorDerivatives);
+        return jacobian_;
     }
 
 }
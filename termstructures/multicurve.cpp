@@ -0,0 +1,306 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/multicurve.hpp>
+#include <ql/math/matrixutilities/bicgstab.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        Real maxAbsolute(const Array& a) {
+            Real result = 0.0;
+            for (Real x : a) {
+                // make sure that NaNs are not ignored
+                if (!(std::fabs(x) <= result))
+                    result = std::fabs(x);
+            }
+            return result;
+        }
+
+        Real bumpSize(Real x) {
+            return 1.0e-6 * std::max(std::fabs(x), Real(1.0));
+        }
+
+    }
+
+    MultiCurve::MultiCurve(Real accuracy, Size maxIterations)
+    : accuracy_(accuracy), maxIterations_(maxIterations) {}
+
+    void MultiCurve::addContributor(const MultiCurveBootstrapContributor* c) {
+        contributors_.push_back(c);
+        dimensions_.clear();
+        update();
+    }
+
+    void MultiCurve::removeContributor(
+                                   const MultiCurveBootstrapContributor* c) {
+        contributors_.erase(
+            std::remove(contributors_.begin(), contributors_.end(), c),
+            contributors_.end());
+        dimensions_.clear();
+        update();
+    }
+
+    void MultiCurve::update() {
+        // if not calculated, the curves were already notified
+        if (calculated_) {
+            LazyObject::update();
+            for (auto c : contributors_)
+                c->updateCurve();
+        }
+    }
+
+    void MultiCurve::setArguments(const Array& x) const {
+        for (Size k=0; k<x.size(); ++k)
+            contributors_[owner_[k]]->setNode(local_[k], x[k]);
+        for (auto c : contributors_)
+            c->updateNodes();
+    }
+
+    void MultiCurve::calculateErrors(Array& errors) const {
+        for (Size k=0; k<errors.size(); ++k)
+            errors[k] = contributors_[owner_[k]]->error(local_[k]);
+    }
+
+    bool MultiCurve::updateJacobian(const Array& x,
+                                    const Array& errors) const {
+        Size n = x.size();
+        Matrix jacobian(n, n, 0.0);
+        std::vector<bool> bumped(contributors_.size());
+        bool fullBump = rows_.empty();
+
+        if (fullBump) {
+            // first calculation: bump one node at a time and reprice
+            // all helpers, which also gives the sparsity pattern
+            rows_.resize(n);
+            Array bumpedErrors(n);
+            for (Size j=0; j<n; ++j) {
+                const MultiCurveBootstrapContributor* c =
+                                                  contributors_[owner_[j]];
+                Real h = bumpSize(x[j]);
+                c->setNode(local_[j], x[j] + h);
+                c->updateNodes();
+                calculateErrors(bumpedErrors);
+                for (Size i=0; i<n; ++i) {
+                    Real d = (bumpedErrors[i] - errors[i]) / h;
+                    // the diagonal is always kept for the factorization
+                    if (d != 0.0 || i == j) {
+                        jacobian[i][j] = d;
+                        rows_[j].push_back(i);
+                    }
+                }
+                c->setNode(local_[j], x[j]);
+                c->updateNodes();
+            }
+
+            // group the nodes not affecting any common helper
+            std::vector<std::vector<bool> > usedRows;
+            for (Size j=0; j<n; ++j) {
+                Size g = 0;
+                for (; g<groups_.size(); ++g) {
+                    bool overlaps = false;
+                    for (Size i : rows_[j]) {
+                        if (usedRows[g][i]) {
+                            overlaps = true;
+                            break;
+                        }
+                    }
+                    if (!overlaps)
+                        break;
+                }
+                if (g == groups_.size()) {
+                    groups_.emplace_back();
+                    usedRows.emplace_back(n, false);
+                }
+                groups_[g].push_back(j);
+                for (Size i : rows_[j])
+                    usedRows[g][i] = true;
+            }
+        } else {
+            for (const std::vector<Size>& group : groups_) {
+                std::fill(bumped.begin(), bumped.end(), false);
+                for (Size j : group) {
+                    contributors_[owner_[j]]->setNode(local_[j],
+                                                      x[j] + bumpSize(x[j]));
+                    bumped[owner_[j]] = true;
+                }
+                for (Size k=0; k<contributors_.size(); ++k) {
+                    if (bumped[k])
+                        contributors_[k]->updateNodes();
+                }
+                for (Size j : group) {
+                    Real h = bumpSize(x[j]);
+                    for (Size i : rows_[j])
+                        jacobian[i][j] =
+                            (contributors_[owner_[i]]->error(local_[i])
+                             - errors[i]) / h;
+                }
+                for (Size j : group)
+                    contributors_[owner_[j]]->setNode(local_[j], x[j]);
+                for (Size k=0; k<contributors_.size(); ++k) {
+                    if (bumped[k])
+                        contributors_[k]->updateNodes();
+                }
+            }
+        }
+
+        // only the non-null entries are stored and factorized
+        Size nonZeros = 0;
+        for (const std::vector<Size>& rows : rows_)
+            nonZeros += rows.size();
+        jacobian_ = SparseMatrix(n, n, nonZeros);
+        for (Size i=0; i<n; ++i) {
+            for (Size j=0; j<n; ++j) {
+                if (jacobian[i][j] != 0.0 || i == j)
+                    jacobian_.push_back(i, j, jacobian[i][j]);
+            }
+        }
+        preconditioner_ = ext::make_shared<SparseILUPreconditioner>(jacobian_);
+        ++jacobianUpdates_;
+        return fullBump;
+    }
+
+    Array MultiCurve::newtonStep(const Array& errors) const {
+        const SparseMatrix& jacobian = jacobian_;
+        const ext::shared_ptr<SparseILUPreconditioner> preconditioner =
+                                                           preconditioner_;
+        try {
+            BiCGstab solver(
+                [&](const Array& x) { return prod(jacobian, x); },
+                errors.size()+10, 1.0e-12,
+                [&](const Array& x) { return preconditioner->apply(x); });
+            return solver.solve(errors).x;
+        } catch (std::exception&) {
+            // the incomplete factorization can fail, e.g., on a null
+            // pivot; fall back on a dense solution
+            Size n = errors.size();
+            Matrix dense(n, n, 0.0);
+            for (Size i=0; i<n; ++i)
+                for (Size j=0; j<n; ++j)
+                    dense[i][j] = jacobian(i, j);
+            return inverse(dense) * errors;
+        }
+    }
+
+    void MultiCurve::performCalculations() const {
+        QL_REQUIRE(!contributors_.empty(), "no curves given");
+        try {
+            solve();
+        } catch (...) {
+            // the curves queried by the helpers during the iterations
+            // hold trial nodes; they must not be used as calculated,
+            // and this instance won't forward notifications to them
+            // until it's calculated again
+            for (auto c : contributors_)
+                c->updateCurve();
+            throw;
+        }
+    }
+
+    void MultiCurve::solve() const {
+        iterations_ = jacobianUpdates_ = 0;
+
+        std::vector<Size> dimensions;
+        for (auto c : contributors_)
+            dimensions.push_back(c->setupCostFunction());
+        if (dimensions != dimensions_) {
+            dimensions_ = dimensions;
+            owner_.clear();
+            local_.clear();
+            for (Size k=0; k<dimensions_.size(); ++k) {
+                for (Size i=0; i<dimensions_[k]; ++i) {
+                    owner_.push_back(k);
+                    local_.push_back(i);
+                }
+            }
+            rows_.clear();
+            groups_.clear();
+            preconditioner_.reset();
+        }
+
+        Size n = owner_.size();
+        Array x(n), errors(n);
+        for (Size k=0; k<n; ++k)
+            x[k] = contributors_[owner_[k]]->node(local_[k]);
+        calculateErrors(errors);
+        Real error = maxAbsolute(errors);
+
+        // the Jacobian is fresh if calculated at the current point
+        bool fresh = false, fullBump = false;
+        Array trialX(n), trialErrors(n), step(n);
+        while (error > accuracy_) {
+            QL_REQUIRE(iterations_ < maxIterations_,
+                       "joint bootstrap: convergence not reached after "
+                       << iterations_ << " iterations; error " << error
+                       << ", required accuracy " << accuracy_);
+            ++iterations_;
+
+            if (!preconditioner_) {
+                fullBump = updateJacobian(x, errors);
+                fresh = true;
+            }
+            step = newtonStep(errors);
+
+            // damped step
+            Real trialError = error;
+            Real lambda = 1.0;
+            for (Size k=0; k<10 && !(trialError < error); ++k, lambda /= 2.0) {
+                trialX = x - lambda * step;
+                try {
+                    setArguments(trialX);
+                    calculateErrors(trialErrors);
+                    trialError = maxAbsolute(trialErrors);
+                } catch (std::exception&) {
+                    trialError = error;
+                }
+            }
+
+            if (!(trialError < error)) {
+                QL_REQUIRE(!fresh || !fullBump,
+                           "joint bootstrap: failed to reduce error "
+                           << error << " after " << iterations_
+                           << " iterations");
+                // try again with an updated Jacobian.  If it was fresh,
+                // its sparsity pattern might be outdated (a node might
+                // have had a null effect on a helper when it was
+                // determined) and all nodes are bumped separately.
+                if (fresh) {
+                    rows_.clear();
+                    groups_.clear();
+                }
+                setArguments(x);
+                preconditioner_.reset();
+                continue;
+            }
+
+            // slow convergence: update the Jacobian at the next step
+            if (!fresh && trialError > 0.5 * error)
+                preconditioner_.reset();
+
+            std::swap(x, trialX);
+            std::swap(errors, trialErrors);
+            error = trialError;
+            fresh = false;
+        }
+
+        for (auto c : contributors_)
+            c->setToValid();
+    }
+
+}
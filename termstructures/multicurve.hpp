@@ -0,0 +1,128 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multicurve.hpp
+    \brief joint bootstrap of linked curves
+    \ingroup termstructures
+*/
+
+#ifndef quantlib_multi_curve_hpp
+#define quantlib_multi_curve_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! curve bootstrapper taking part in a joint bootstrap
+    /*! A contributor exposes the nodes of its curve at the alive
+        pillars as unknowns of the joint problem, and the quote errors
+        of the corresponding helpers as its equations; therefore, it
+        provides as many equations as unknowns.
+    */
+    class MultiCurveBootstrapContributor {
+      public:
+        virtual ~MultiCurveBootstrapContributor() = default;
+        /*! prepares the curve and its helpers for the calculation of
+            the errors and returns the number of unknowns.
+        */
+        virtual Size setupCostFunction() const = 0;
+        virtual Real node(Size i) const = 0;
+        //! updateNodes() must be called after the nodes are changed
+        virtual void setNode(Size i, Real value) const = 0;
+        virtual void updateNodes() const = 0;
+        virtual Real error(Size i) const = 0;
+        //! flags the current nodes as a solution
+        virtual void setToValid() const = 0;
+        //! notifies the curve that the joint solution is outdated
+        virtual void updateCurve() const = 0;
+    };
+
+    //! Joint bootstrap of linked curves
+    /*! Curves whose helpers depend on one another (e.g., projection
+        curves depending on a discount curve, or cross-currency
+        curves) are usually bootstrapped one at a time, each
+        triggering the bootstrap of the curves it depends on.  Curves
+        using MultiCurveBootstrap as their bootstrapper and sharing an
+        instance of this class are bootstrapped together instead,
+        solving for all their nodes at once with a Newton method.
+
+        The Jacobian is calculated by finite differences.  Its
+        sparsity pattern (each helper only depends on a few nodes) is
+        determined on the first calculation; afterwards, nodes which
+        don't affect any common helper are bumped together, and only
+        the helpers depending on them are repriced.  The pattern is
+        determined again if a Newton step based on it fails.  The
+        Jacobian is stored as a sparse matrix together with its
+        incomplete LU factorization, and the Newton steps are found
+        with the BiCGstab solver.  It is kept across recalculations
+        and only updated when the convergence slows down; when just a
+        few quotes change, no update is usually needed.
+
+        Instances don't hold references to the curves or their
+        helpers, which would cause reference cycles when the helpers
+        of a curve refer to another curve; they are kept alive by the
+        curves using them, and notified by their bootstrappers.
+
+        \ingroup yieldtermstructures
+    */
+    class MultiCurve : public LazyObject {
+      public:
+        explicit MultiCurve(Real accuracy = 1.0e-12, Size maxIterations = 100);
+        //! \name Observer interface
+        //@{
+        void update() override;
+        //@}
+        //! \name Inspectors
+        //@{
+        //! Newton iterations performed in the last bootstrap
+        Size iterations() const { return iterations_; }
+        //! Jacobian updates performed in the last bootstrap
+        Size jacobianUpdates() const { return jacobianUpdates_; }
+        //@}
+        //! \name Contributors
+        //@{
+        void addContributor(const MultiCurveBootstrapContributor* c);
+        void removeContributor(const MultiCurveBootstrapContributor* c);
+        //@}
+      private:
+        template <class> friend class MultiCurveBootstrap;
+        void performCalculations() const override;
+        void solve() const;
+        void setArguments(const Array& x) const;
+        void calculateErrors(Array& errors) const;
+        // returns whether the sparsity pattern was determined again
+        bool updateJacobian(const Array& x, const Array& errors) const;
+        Array newtonStep(const Array& errors) const;
+        std::vector<const MultiCurveBootstrapContributor*> contributors_;
+        Real accuracy_;
+        Size maxIterations_;
+        // structure of the problem; reset when the dimensions change
+        mutable std::vector<Size> dimensions_;
+        mutable std::vector<Size> owner_, local_;
+        mutable std::vector<std::vector<Size> > rows_, groups_;
+        mutable SparseMatrix jacobian_;
+        mutable ext::shared_ptr<SparseILUPreconditioner> preconditioner_;
+        mutable Size iterations_ = 0, jacobianUpdates_ = 0;
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,270 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multicurvebootstrap.hpp
+    \brief bootstrapper for curves solved jointly
+    \ingroup termstructures
+*/
+
+#ifndef quantlib_multi_curve_bootstrap_hpp
+#define quantlib_multi_curve_bootstrap_hpp
+
+#include <ql/termstructures/multicurve.hpp>
+#include <ql/termstructures/iterativebootstrap.hpp>
+#include <ql/settings.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        // forwards the notifications of the helpers of a curve to the
+        // joint bootstrap, without the latter holding references to
+        // the helpers
+        class MultiCurveNotifier : public Observer {
+          public:
+            explicit MultiCurveNotifier(MultiCurve* multiCurve)
+            : multiCurve_(multiCurve) {}
+            void update() override { multiCurve_->update(); }
+          private:
+            MultiCurve* multiCurve_;
+        };
+
+    }
+
+    //! Bootstrapper delegating to a joint bootstrap of linked curves
+    /*! Curves using this bootstrapper and sharing the same MultiCurve
+        instance are solved together; bootstrapping any of them
+        bootstraps all of them.
+
+        \code
+        auto multiCurve = ext::make_shared<MultiCurve>();
+        typedef PiecewiseYieldCurve<Discount, LogLinear,
+                                    MultiCurveBootstrap> Curve;
+        auto ois = ext::make_shared<Curve>(today, oisHelpers, dayCounter,
+                                           Curve::bootstrap_type(multiCurve));
+        auto euribor6m = ext::make_shared<Curve>(today, swapHelpers,
+                                                 dayCounter,
+                                                 Curve::bootstrap_type(multiCurve));
+        \endcode
+
+        \warning curves with jumps are not supported.
+    */
+    template <class Curve>
+    class MultiCurveBootstrap : public MultiCurveBootstrapContributor {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+      public:
+        explicit MultiCurveBootstrap(ext::shared_ptr<MultiCurve> multiCurve);
+        MultiCurveBootstrap(const MultiCurveBootstrap&) = default;
+        MultiCurveBootstrap(MultiCurveBootstrap&&) = default;
+        MultiCurveBootstrap& operator=(const MultiCurveBootstrap&) = delete;
+        MultiCurveBootstrap& operator=(MultiCurveBootstrap&&) = delete;
+        ~MultiCurveBootstrap() override;
+        void setup(Curve* ts);
+        void calculate() const;
+        //! \name MultiCurveBootstrapContributor interface
+        //@{
+        Size setupCostFunction() const override;
+        Real node(Size i) const override;
+        void setNode(Size i, Real value) const override;
+        void updateNodes() const override;
+        Real error(Size i) const override;
+        void setToValid() const override;
+        void updateCurve() const override;
+        //@}
+      private:
+        void initialize() const;
+        ext::shared_ptr<MultiCurve> multiCurve_;
+        ext::shared_ptr<detail::MultiCurveNotifier> notifier_;
+        Curve* ts_ = nullptr;
+        Size n_ = 0;
+        mutable bool initialized_ = false, validCurve_ = false;
+        mutable Size firstAliveHelper_, alive_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    MultiCurveBootstrap<Curve>::MultiCurveBootstrap(
+                                      ext::shared_ptr<MultiCurve> multiCurve)
+    : multiCurve_(std::move(multiCurve)) {
+        QL_REQUIRE(multiCurve_, "null multi-curve given");
+    }
+
+    template <class Curve>
+    MultiCurveBootstrap<Curve>::~MultiCurveBootstrap() {
+        if (ts_ != nullptr)
+            multiCurve_->removeContributor(this);
+    }
+
+    template <class Curve>
+    void MultiCurveBootstrap<Curve>::setup(Curve* ts) {
+        QL_REQUIRE(ts_ == nullptr, "bootstrapper already in use");
+        QL_REQUIRE(!detail::hasJumps(ts, 0),
+                   "jumps not supported by joint bootstrap");
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        QL_REQUIRE(n_ > 0, "no bootstrap helpers given");
+        // the joint bootstrap depends on the helpers of all curves,
+        // and each curve depends on the joint bootstrap
+        notifier_ = ext::make_shared<detail::MultiCurveNotifier>(
+                                                         multiCurve_.get());
+        for (Size j=0; j<n_; ++j) {
+            ts_->registerWith(ts_->instruments_[j]);
+            notifier_->registerWith(ts_->instruments_[j]);
+        }
+        if (ts_->moving_)
+            notifier_->registerWith(Settings::instance().evaluationDate());
+        multiCurve_->addContributor(this);
+
+        // do not initialize yet: instruments could be invalid here
+        // but valid later when bootstrapping is actually required
+    }
+
+    template <class Curve>
+    void MultiCurveBootstrap<Curve>::initialize() const {
+        // ensure helpers are sorted
+        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
+                  detail::BootstrapHelperSorter());
+        // skip expired helpers
+        Date firstDate = Traits::initialDate(ts_);
+        QL_REQUIRE(ts_->instruments_[n_-1]->pillarDate()>firstDate,
+                   "all instruments expired");
+        firstAliveHelper_ = 0;
+        while (ts_->instruments_[firstAliveHelper_]->pillarDate() <= firstDate)
+            ++firstAliveHelper_;
+        alive_ = n_-firstAliveHelper_;
+        QL_REQUIRE(alive_+1 >= Interpolator::requiredPoints,
+                   "not enough alive instruments: " << alive_ <<
+                   " provided, " << Interpolator::requiredPoints-1 <<
+                   " required");
+
+        std::vector<Date>& dates = ts_->dates_;
+        std::vector<Time>& times = ts_->times_;
+        dates.resize(alive_+1);
+        times.resize(alive_+1);
+        dates[0] = firstDate;
+        times[0] = ts_->timeFromReference(dates[0]);
+        Date maxDate = firstDate;
+        for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+            const ext::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            dates[i] = helper->pillarDate();
+            times[i] = ts_->timeFromReference(dates[i]);
+            QL_REQUIRE(dates[i-1]!=dates[i],
+                       "more than one instrument with pillar " << dates[i]);
+            maxDate = std::max(maxDate, helper->latestRelevantDate());
+        }
+        ts_->maxDate_ = maxDate;
+
+        if (!validCurve_ || ts_->data_.size()!=alive_+1) {
+            ts_->data_ = std::vector<Real>(alive_+1, Traits::initialValue(ts_));
+            validCurve_ = false;
+        }
+        initialized_ = true;
+    }
+
+    template <class Curve>
+    void MultiCurveBootstrap<Curve>::calculate() const {
+        multiCurve_->calculate();
+    }
+
+    template <class Curve>
+    Size MultiCurveBootstrap<Curve>::setupCostFunction() const {
+        if (!initialized_ || ts_->moving_)
+            initialize();
+
+        for (Size j=firstAliveHelper_; j<n_; ++j) {
+            const ext::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            QL_REQUIRE(helper->quote()->isValid(),
+                       io::ordinal(j + 1) << " instrument (maturity: " <<
+                       helper->maturityDate() << ", pillar: " <<
+                       helper->pillarDate() << ") has an invalid quote");
+            // see the corresponding note in IterativeBootstrap
+            helper->setTermStructure(const_cast<Curve*>(ts_));
+        }
+
+        if (!validCurve_) {
+            // build a first guess pillar by pillar.  As in
+            // IterativeBootstrap, the interpolation is extended a point
+            // at a time since the guess at a pillar might use the curve
+            // up to the previous one (e.g., for zero or forward rates.)
+            const std::vector<Time>& times = ts_->times_;
+            const std::vector<Real>& data = ts_->data_;
+            for (Size i=1; i<=alive_; ++i) {
+                Traits::updateGuess(
+                    ts_->data_,
+                    Traits::guess(i, ts_, false, firstAliveHelper_), i);
+                try {
+                    ts_->interpolation_ = ts_->interpolator_.interpolate(
+                        times.begin(), times.begin()+i+1, data.begin());
+                } catch (...) {
+                    if (!Interpolator::global)
+                        throw;
+                    // use Linear while the target interpolation
+                    // doesn't have enough points yet
+                    ts_->interpolation_ = Linear().interpolate(
+                        times.begin(), times.begin()+i+1, data.begin());
+                }
+                ts_->interpolation_.update();
+            }
+            ts_->interpolation_ = ts_->interpolator_.interpolate(
+                times.begin(), times.end(), data.begin());
+        }
+        ts_->interpolation_.update();
+
+        // until the joint bootstrap succeeds
+        validCurve_ = false;
+        return alive_;
+    }
+
+    template <class Curve>
+    Real MultiCurveBootstrap<Curve>::node(Size i) const {
+        return ts_->data_[i+1];
+    }
+
+    template <class Curve>
+    void MultiCurveBootstrap<Curve>::setNode(Size i, Real value) const {
+        Traits::updateGuess(ts_->data_, value, i+1);
+    }
+
+    template <class Curve>
+    void MultiCurveBootstrap<Curve>::updateNodes() const {
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    Real MultiCurveBootstrap<Curve>::error(Size i) const {
+        return ts_->instruments_[firstAliveHelper_+i]->quoteError();
+    }
+
+    template <class Curve>
+    void MultiCurveBootstrap<Curve>::setToValid() const {
+        validCurve_ = true;
+    }
+
+    template <class Curve>
+    void MultiCurveBootstrap<Curve>::updateCurve() const {
+        ts_->update();
+    }
+
+}
+
+#endif
@@ -95,6 +95,9 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const override;
+        void batchDiscountImpl(const Time* t,
+                               DiscountFactor* df,
+                               Size n) const override;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -168,6 +171,25 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::batchDiscountImpl(const Time* t,
+                                                         DiscountFactor* df,
+                                                         Size n) const {
+        Time tMax = this->times_.back();
+        DiscountFactor dMax = this->data_.back();
+        Rate instFwdMax = Null<Rate>();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] <= tMax) {
+                df[i] = this->interpolation_(t[i], true);
+            } else {
+                // flat fwd extrapolation
+                if (instFwdMax == Null<Rate>())
+                    instFwdMax = - this->interpolation_.derivative(tMax) / dMax;
+                df[i] = dMax * std::exp(- instFwdMax * (t[i]-tMax));
+            }
+        }
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
@@ -84,6 +84,9 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const override;
+        void batchDiscountImpl(const Time* t,
+                               DiscountFactor* df,
+                               Size n) const override;
         //@}
 
         Handle<Quote> forward_;
@@ -103,6 +106,20 @@ namespace QuantLib {
         calculate();
         return rate_.discountFactor(t);
     }
+
+    inline void FlatForward::batchDiscountImpl(const Time* t,
+                                               DiscountFactor* df,
+                                               Size n) const {
+        calculate();
+        if (compounding_ == Continuous) {
+            Rate r = rate_.rate();
+            for (Size i=0; i<n; ++i)
+                df[i] = DiscountFactor(std::exp(-r*t[i]));
+        } else {
+            for (Size i=0; i<n; ++i)
+                df[i] = rate_.discountFactor(t[i]);
+        }
+    }
   
     inline void FlatForward::performCalculations() const {
         rate_ = InterestRate(forward_->value(), dayCounter(),
@@ -67,6 +67,12 @@ namespace QuantLib {
         /* This method must disappear should the spread become a curve */
         Rate zeroYieldImpl(Time t) const override;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void batchDiscountImpl(const Time* t,
+                               DiscountFactor* df,
+                               Size n) const override;
+        //@}
       private:
         Handle<YieldTermStructure> originalCurve_;
         Handle<Quote> spread_;
@@ -126,6 +132,15 @@ namespace QuantLib {
             + spread_->value();
     }
 
+    inline void ForwardSpreadedTermStructure::batchDiscountImpl(const Time* t,
+                                                                DiscountFactor* df,
+                                                                Size n) const {
+        originalCurve_->zeroRate(t, df, n, Continuous, NoFrequency, true);
+        Spread spread = spread_->value();
+        for (Size i=0; i<n; ++i)
+            df[i] = DiscountFactor(std::exp(-(df[i] + spread)*t[i]));
+    }
+
 }
 
 #endif
@@ -165,6 +165,17 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Sensitivities
+        //@{
+        /*! Derivatives of the nodes at the pillars with respect to
+            the quotes of the alive helpers, sorted by pillar.  Only
+            available with bootstrappers providing them, such as
+            IterativeBootstrap.
+
+            \warning jumps are assumed not to depend on the quotes.
+        */
+        const Matrix& jacobian() const;
+        //@}
         //! \name Observer interface
         //@{
         void update() override;
@@ -176,6 +187,9 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const override;
+        void batchDiscountImpl(const Time* t,
+                               DiscountFactor* df,
+                               Size n) const override;
         // data members
         std::vector<ext::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -225,6 +239,12 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseYieldCurve<C,I,B>::jacobian() const {
+        calculate();
+        return bootstrap_.jacobian();
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
@@ -246,6 +266,14 @@ namespace QuantLib {
         return base_curve::discountImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseYieldCurve<C,I,B>::batchDiscountImpl(const Time* t,
+                                                              DiscountFactor* df,
+                                                              Size n) const {
+        calculate();
+        base_curve::batchDiscountImpl(t, df, n);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
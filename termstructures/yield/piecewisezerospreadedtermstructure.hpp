@@ -66,6 +66,7 @@ namespace QuantLib {
     protected:
       //! returns the spreaded zero yield rate
       Rate zeroYieldImpl(Time) const override;
+      void batchZeroYieldImpl(const Time* t, Rate* r, Size n) const override;
       void update() override;
 
     private:
@@ -151,6 +152,24 @@ namespace QuantLib {
         return spreadedRate.equivalentRate(Continuous, NoFrequency, t);
     }
 
+    template <class T>
+    inline void
+    InterpolatedPiecewiseZeroSpreadedTermStructure<T>::batchZeroYieldImpl(const Time* t,
+                                                                          Rate* r,
+                                                                          Size n) const {
+        originalCurve_->zeroRate(t, r, n, comp_, freq_, true);
+        if (comp_ == Continuous) {
+            for (Size i=0; i<n; ++i)
+                r[i] += calcSpread(t[i]);
+            return;
+        }
+        DayCounter dc = originalCurve_->dayCounter();
+        for (Size i=0; i<n; ++i) {
+            InterestRate spreadedRate(r[i] + calcSpread(t[i]), dc, comp_, freq_);
+            r[i] = spreadedRate.equivalentRate(Continuous, NoFrequency, t[i]);
+        }
+    }
+
     template <class T>
     inline Spread
     InterpolatedPiecewiseZeroSpreadedTermStructure<T>::calcSpread(Time t) const {
@@ -102,6 +102,7 @@ namespace QuantLib {
         //! \name ZeroYieldStructure implementation
         //@{
         Rate zeroYieldImpl(Time t) const override;
+        void batchZeroYieldImpl(const Time* t, Rate* r, Size n) const override;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -169,6 +170,25 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::batchZeroYieldImpl(const Time* t,
+                                                      Rate* r,
+                                                      Size n) const {
+        Time tMax = this->times_.back();
+        Rate zMax = this->data_.back();
+        Rate instFwdMax = Null<Rate>();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] <= tMax) {
+                r[i] = this->interpolation_(t[i], true);
+            } else {
+                // flat fwd extrapolation
+                if (instFwdMax == Null<Rate>())
+                    instFwdMax = zMax + tMax * this->interpolation_.derivative(tMax);
+                r[i] = (zMax * tMax + instFwdMax * (t[i]-tMax)) / t[i];
+            }
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
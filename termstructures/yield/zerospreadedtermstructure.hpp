@@ -67,6 +67,7 @@ namespace QuantLib {
       protected:
         //! returns the spreaded zero yield rate
         Rate zeroYieldImpl(Time) const override;
+        void batchZeroYieldImpl(const Time* t, Rate* r, Size n) const override;
         //! returns the spreaded forward rate
         /* This method must disappear should the spread become a curve */
         Rate forwardImpl(Time) const;
@@ -140,6 +141,24 @@ namespace QuantLib {
         return spreadedRate.equivalentRate(Continuous, NoFrequency, t);
     }
 
+    inline void ZeroSpreadedTermStructure::batchZeroYieldImpl(const Time* t,
+                                                              Rate* r,
+                                                              Size n) const {
+        originalCurve_->zeroRate(t, r, n, comp_, freq_, true);
+        Spread spread = spread_->value();
+        if (comp_ == Continuous) {
+            for (Size i=0; i<n; ++i)
+                r[i] += spread;
+            return;
+        }
+        // to be fixed: user-defined daycounter should be used
+        DayCounter dc = originalCurve_->dayCounter();
+        for (Size i=0; i<n; ++i) {
+            InterestRate spreadedRate(r[i] + spread, dc, comp_, freq_);
+            r[i] = spreadedRate.equivalentRate(Continuous, NoFrequency, t[i]);
+        }
+    }
+
     inline Rate ZeroSpreadedTermStructure::forwardImpl(Time t) const {
         return originalCurve_->forwardRate(t, t, comp_, freq_, true)
             + spread_->value();
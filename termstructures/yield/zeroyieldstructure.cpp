@@ -20,6 +20,7 @@
 */
 
 #include <ql/termstructures/yield/zeroyieldstructure.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -42,4 +43,41 @@ namespace QuantLib {
                                     const std::vector<Date>& jumpDates)
     : YieldTermStructure(settlementDays, cal, dc, jumps, jumpDates) {}
 
+    void ZeroYieldStructure::batchZeroYieldImpl(const Time* t,
+                                                Rate* r,
+                                                Size n) const {
+        for (Size i=0; i<n; ++i)
+            r[i] = zeroYieldImpl(t[i]);
+    }
+
+    void ZeroYieldStructure::batchDiscountImpl(const Time* t,
+                                               DiscountFactor* df,
+                                               Size n) const {
+        if (std::find(t, t+n, 0.0) == t+n) {
+            batchZeroYieldImpl(t, df, n);
+            for (Size i=0; i<n; ++i)
+                df[i] = DiscountFactor(std::exp(-df[i]*t[i]));
+            return;
+        }
+
+        // as in discountImpl(Time), null times are not passed to the
+        // zero-yield calculation, which might throw
+        std::vector<Time> times;
+        times.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            if (t[i] != 0.0)
+                times.push_back(t[i]);
+        }
+        std::vector<Rate> rates(times.size());
+        batchZeroYieldImpl(times.data(), rates.data(), times.size());
+        for (Size i=0, j=0; i<n; ++i) {
+            if (t[i] == 0.0) {
+                df[i] = 1.0;
+            } else {
+                df[i] = DiscountFactor(std::exp(-rates[j]*t[i]));
+                ++j;
+            }
+        }
+    }
+
 }
@@ -74,6 +74,13 @@ namespace QuantLib {
         //@{
         //! zero-yield calculation
         virtual Rate zeroYieldImpl(Time) const = 0;
+        /*! batch zero-yield calculation; the default implementation
+            calls zeroYieldImpl() for each time.  It is never passed
+            null times.
+        */
+        virtual void batchZeroYieldImpl(const Time* t,
+                                        Rate* r,
+                                        Size n) const;
         //@}
 
         //! \name YieldTermStructure implementation
@@ -82,6 +89,12 @@ namespace QuantLib {
             from the zero yield.
         */
         DiscountFactor discountImpl(Time) const override;
+        /*! Returns the discount factors for the given times
+            calculating them from the batch zero yields.
+        */
+        void batchDiscountImpl(const Time* t,
+                               DiscountFactor* df,
+                               Size n) const override;
         //@}
     };
 
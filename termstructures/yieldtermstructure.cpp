@@ -21,6 +21,7 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <cmath>
 #include <utility>
 
 namespace QuantLib {
@@ -80,6 +81,50 @@ namespace QuantLib {
         if (jumps_.empty())
             return discountImpl(t);
 
+        return jumpEffect(t) * discountImpl(t);
+    }
+
+    void YieldTermStructure::discount(const Time* t,
+                                      DiscountFactor* df,
+                                      Size n,
+                                      bool extrapolate) const {
+        if (n == 0)
+            return;
+
+        checkTimes(t, n, extrapolate);
+
+        batchDiscountImpl(t, df, n);
+
+        if (!jumps_.empty()) {
+            for (Size i=0; i<n; ++i)
+                df[i] *= jumpEffect(t[i]);
+        }
+    }
+
+    void YieldTermStructure::batchDiscountImpl(const Time* t,
+                                               DiscountFactor* df,
+                                               Size n) const {
+        for (Size i=0; i<n; ++i)
+            df[i] = discountImpl(t[i]);
+    }
+
+    void YieldTermStructure::checkTimes(const Time* t,
+                                        Size n,
+                                        bool extrapolate) const {
+        Time tMin = t[0], tMax = t[0];
+        for (Size i=0; i<n; ++i) {
+            if (std::isnan(t[i]))
+                checkRange(t[i], extrapolate);
+            if (t[i] < tMin)
+                tMin = t[i];
+            else if (t[i] > tMax)
+                tMax = t[i];
+        }
+        checkRange(tMin, extrapolate);
+        checkRange(tMax, extrapolate);
+    }
+
+    DiscountFactor YieldTermStructure::jumpEffect(Time t) const {
         DiscountFactor jumpEffect = 1.0;
         for (Size i=0; i<nJumps_; ++i) {
             if (jumpTimes_[i]>0 && jumpTimes_[i]<t) {
@@ -92,7 +137,7 @@ namespace QuantLib {
                 jumpEffect *= thisJump;
             }
         }
-        return jumpEffect * discountImpl(t);
+        return jumpEffect;
     }
 
     InterestRate YieldTermStructure::zeroRate(const Date& d,
@@ -170,6 +215,66 @@ namespace QuantLib {
                                          t2-t1);
     }
 
+    void YieldTermStructure::zeroRate(const Time* t,
+                                      Rate* r,
+                                      Size n,
+                                      Compounding comp,
+                                      Frequency freq,
+                                      bool extrapolate) const {
+        if (n == 0)
+            return;
+
+        std::vector<Time> times(t, t+n);
+        for (Size i=0; i<n; ++i) {
+            if (times[i]==0.0)
+                times[i] = dt;
+        }
+        std::vector<DiscountFactor> discounts(n);
+        discount(times.data(), discounts.data(), n, extrapolate);
+        DayCounter dc = dayCounter();
+        for (Size i=0; i<n; ++i)
+            r[i] = InterestRate::impliedRate(1.0/discounts[i],
+                                             dc, comp, freq,
+                                             times[i]).rate();
+    }
+
+    void YieldTermStructure::forwardRate(const Time* t1,
+                                         const Time* t2,
+                                         Rate* r,
+                                         Size n,
+                                         Compounding comp,
+                                         Frequency freq,
+                                         bool extrapolate) const {
+        // layout: start times in [0,n), end times in [n,2n)
+        std::vector<Time> times(2*n);
+        for (Size i=0; i<n; ++i) {
+            if (t2[i]==t1[i]) {
+                times[i] = std::max(t1[i] - dt/2.0, 0.0);
+                times[n+i] = times[i] + dt;
+            } else {
+                QL_REQUIRE(t2[i]>t1[i],
+                           "t2 (" << t2[i] << ") < t1 (" << t1[i] << ")");
+                times[i] = t1[i];
+                times[n+i] = t2[i];
+            }
+        }
+        if (n == 0)
+            return;
+
+        // the requested times are checked; the shifted ones used for
+        // instantaneous forwards may extrapolate, as in the scalar case
+        checkTimes(t1, n, extrapolate);
+        checkTimes(t2, n, extrapolate);
+
+        std::vector<DiscountFactor> discounts(2*n);
+        discount(times.data(), discounts.data(), 2*n, true);
+        DayCounter dc = dayCounter();
+        for (Size i=0; i<n; ++i)
+            r[i] = InterestRate::impliedRate(discounts[i]/discounts[n+i],
+                                             dc, comp, freq,
+                                             times[n+i]-times[i]).rate();
+    }
+
     void YieldTermStructure::update() {
         TermStructure::update();
         Date newReference = Date();
@@ -75,6 +75,17 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! Batch version of the above; df[i] is set to the discount
+            factor at time t[i] for i in [0,n).  The range is checked
+            once against the extreme times, and the calculation is
+            delegated to batchDiscountImpl() so that derived curves
+            can share work across times.  Sorted times are handled
+            most efficiently.
+        */
+        void discount(const Time* t,
+                      DiscountFactor* df,
+                      Size n,
+                      bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -101,6 +112,16 @@ namespace QuantLib {
                               Compounding comp,
                               Frequency freq = Annual,
                               bool extrapolate = false) const;
+
+        /*! Batch version of the above; r[i] is set to the zero rate
+            at time t[i] for i in [0,n).
+        */
+        void zeroRate(const Time* t,
+                      Rate* r,
+                      Size n,
+                      Compounding comp,
+                      Frequency freq = Annual,
+                      bool extrapolate = false) const;
         //@}
 
         /*! \name Forward rates
@@ -142,6 +163,17 @@ namespace QuantLib {
                                  Compounding comp,
                                  Frequency freq = Annual,
                                  bool extrapolate = false) const;
+
+        /*! Batch version of the above; r[i] is set to the forward
+            rate between times t1[i] and t2[i] for i in [0,n).
+        */
+        void forwardRate(const Time* t1,
+                         const Time* t2,
+                         Rate* r,
+                         Size n,
+                         Compounding comp,
+                         Frequency freq = Annual,
+                         bool extrapolate = false) const;
         //@}
 
         //! \name Jump inspectors
@@ -165,10 +197,18 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! batch discount factor calculation; the default
+            implementation calls discountImpl() for each time.
+        */
+        virtual void batchDiscountImpl(const Time* t,
+                                       DiscountFactor* df,
+                                       Size n) const;
         //@}
       private:
         // methods
         void setJumps(const Date& referenceDate);
+        void checkTimes(const Time* t, Size n, bool extrapolate) const;
+        DiscountFactor jumpEffect(Time t) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
@@ -24,9 +24,195 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
+#include <cstdlib>
 
 namespace QuantLib {
 
+    namespace {
+
+        int bitCount(std::uint64_t x) {
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return int((x * 0x0101010101010101ULL) >> 56);
+        }
+
+    }
+
+    const Date::serial_type Calendar::Impl::firstCachedSerial;
+    const Date::serial_type Calendar::Impl::lastCachedSerial;
+    const Date::serial_type Calendar::Impl::blockDays;
+    const Date::serial_type Calendar::Impl::warmUpDays;
+
+    const unsigned long Calendar::Impl::fillingBlock;
+
+    void Calendar::Impl::businessDaysChanged() {
+        businessDaysGeneration_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    unsigned long Calendar::Impl::businessDaysGeneration() const {
+        return businessDaysGeneration_.load(std::memory_order_acquire);
+    }
+
+    unsigned long Calendar::Impl::businessDaysGeneration(const Calendar& c) {
+        return c.impl_ != nullptr ? c.impl_->businessDaysGeneration() : 0;
+    }
+
+    bool Calendar::Impl::isBusinessDayUncached(const Date& d) const {
+#ifdef QL_HIGH_RESOLUTION_DATE
+        const Date _d(d.dayOfMonth(), d.month(), d.year());
+#else
+        const Date& _d = d;
+#endif
+
+        if (!addedHolidays.empty() &&
+            addedHolidays.find(_d) != addedHolidays.end())
+            return false;
+
+        if (!removedHolidays.empty() &&
+            removedHolidays.find(_d) != removedHolidays.end())
+            return true;
+
+        return isBusinessDay(_d);
+    }
+
+    void Calendar::Impl::fillCacheBlock(Date::serial_type i) const {
+        const Date::serial_type cachedDays = lastCachedSerial - firstCachedSerial + 1;
+        const Date::serial_type nBlocks = (cachedDays + blockDays - 1) / blockDays;
+
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+
+        CacheSlot* slots = cache_.load(std::memory_order_relaxed);
+        if (slots == nullptr) {
+            cacheSlots_.reset(new CacheSlot[nBlocks]);
+            for (Date::serial_type j=0; j<nBlocks; ++j)
+                cacheSlots_[j].store(nullptr, std::memory_order_relaxed);
+            slots = cacheSlots_.get();
+            cache_.store(slots, std::memory_order_release);
+        }
+
+        // read before filling the block; if the business days change
+        // in the meantime, the block will be filled again
+        unsigned long generation = businessDaysGeneration();
+        CacheBlock* block = slots[i].load(std::memory_order_relaxed);
+        if (block != nullptr &&
+            block->generation.load(std::memory_order_relaxed) == generation)
+            return;
+
+        // days past the end of the range are marked as holidays
+        // and never queried
+        std::uint64_t days[blockDays/64] = {};
+        Date::serial_type businessDays = 0;
+        Date::serial_type first = firstCachedSerial + i*blockDays;
+        Date::serial_type last = std::min(first + blockDays - 1, lastCachedSerial);
+        for (Date::serial_type s = first; s <= last; ++s) {
+            if (isBusinessDayUncached(Date(s))) {
+                Date::serial_type k = s - first;
+                days[k/64] |= std::uint64_t(1) << (k%64);
+                ++businessDays;
+            }
+        }
+
+        bool published = (block != nullptr);
+        if (!published) {
+            cacheBlocks_.emplace_back(new CacheBlock);
+            block = cacheBlocks_.back().get();
+        }
+        // readers of a published block will see the change of
+        // generation after reading the new contents, and retry
+        block->generation.store(fillingBlock, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (Date::serial_type w=0; w<blockDays/64; ++w)
+            block->days[w].store(days[w], std::memory_order_relaxed);
+        block->businessDays.store(businessDays, std::memory_order_relaxed);
+        block->generation.store(generation, std::memory_order_release);
+        if (!published)
+            slots[i].store(block, std::memory_order_release);
+    }
+
+    Date::serial_type Calendar::Impl::businessDaysCached(Date::serial_type from,
+                                                         Date::serial_type to) const {
+        Date::serial_type result = 0;
+        Date::serial_type i = from;
+        while (i <= to) {
+            Date::serial_type k = i % blockDays, businessDays;
+            std::uint64_t word;
+            cachedWord(i / blockDays, k/64, word, businessDays);
+            if (k == 0 && to - i >= blockDays - 1) {
+                // whole block
+                result += businessDays;
+                i += blockDays;
+                continue;
+            }
+            Date::serial_type bit = k % 64;
+            word >>= bit;
+            Date::serial_type remaining = 64 - bit;
+            if (to - i + 1 < remaining) {
+                remaining = to - i + 1;
+                word &= (std::uint64_t(1) << remaining) - 1;
+            }
+            result += bitCount(word);
+            i += remaining;
+        }
+        return result;
+    }
+
+    Date::serial_type Calendar::Impl::advanceCached(Date::serial_type offset,
+                                                    Integer n) const {
+        const Date::serial_type lastOffset = lastCachedSerial - firstCachedSerial;
+        if (n > 0) {
+            Date::serial_type i = offset + 1;
+            while (i <= lastOffset) {
+                Date::serial_type k = i % blockDays, businessDays;
+                std::uint64_t word;
+                cachedWord(i / blockDays, k/64, word, businessDays);
+                if (k == 0 && businessDays < n) {
+                    n -= businessDays;
+                    i += blockDays;
+                    continue;
+                }
+                Date::serial_type bit = k % 64;
+                word >>= bit;
+                Integer count = bitCount(word);
+                if (count < n) {
+                    n -= count;
+                    i += 64 - bit;
+                    continue;
+                }
+                for (;; word >>= 1, ++i) {
+                    if ((word & 1) != 0 && --n == 0)
+                        return i;
+                }
+            }
+        } else {
+            Date::serial_type i = offset - 1;
+            while (i >= 0) {
+                Date::serial_type k = i % blockDays, businessDays;
+                std::uint64_t word;
+                cachedWord(i / blockDays, k/64, word, businessDays);
+                if (k == blockDays - 1 && businessDays < -n) {
+                    n += businessDays;
+                    i -= blockDays;
+                    continue;
+                }
+                Date::serial_type bit = k % 64;
+                word <<= 63 - bit;
+                Integer count = bitCount(word);
+                if (count < -n) {
+                    n += count;
+                    i -= bit + 1;
+                    continue;
+                }
+                for (;; word <<= 1, --i) {
+                    if ((word >> 63) != 0 && ++n == 0)
+                        return i;
+                }
+            }
+        }
+        return -1;
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no calendar implementation provided");
 
@@ -42,6 +228,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(_d))
             impl_->addedHolidays.insert(_d);
+        impl_->businessDaysChanged();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -59,11 +246,13 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(_d))
             impl_->removedHolidays.insert(_d);
+        impl_->businessDaysChanged();
     }
 
     void Calendar::resetAddedAndRemovedHolidays() {
         impl_->addedHolidays.clear();
         impl_->removedHolidays.clear();
+        impl_->businessDaysChanged();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -120,6 +309,15 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+            Date::serial_type offset = d.serialNumber() - Impl::firstCachedSerial;
+            if (impl_ && offset >= 0
+                && offset <= Impl::lastCachedSerial - Impl::firstCachedSerial
+                && impl_->useCache(std::abs(n))) {
+                Date::serial_type result = impl_->advanceCached(offset, n);
+                if (result >= 0)
+                    return Date(result + Impl::firstCachedSerial);
+            }
+            // past the cached range; the loop below raises the error
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
@@ -164,7 +362,16 @@ namespace QuantLib {
                                                     bool includeLast) const {
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
+            const Date::serial_type lastOffset =
+                Impl::lastCachedSerial - Impl::firstCachedSerial;
+            Date::serial_type first =
+                std::min(from, to).serialNumber() - Impl::firstCachedSerial;
+            Date::serial_type last =
+                std::max(from, to).serialNumber() - Impl::firstCachedSerial;
+            if (impl_ && first >= 0 && last <= lastOffset
+                && impl_->useCache(last - first + 1)) {
+                wd = impl_->businessDaysCached(first, last);
+            } else if (from < to) {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
                 for (Date d = from; d < to; ++d) {
@@ -32,6 +32,10 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <ql/shared_ptr.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 #include <string>
@@ -59,6 +63,7 @@ namespace QuantLib {
               invocation.
     */
     class Calendar {
+        friend class ScheduleCache;
       protected:
         //! abstract base class for calendar implementations
         class Impl {
@@ -68,6 +73,72 @@ namespace QuantLib {
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+          protected:
+            /*! Derived implementations whose business days can change
+                after construction must call this method after each
+                change, so that cached business days are recalculated.
+                Added and removed holidays are already taken care of.
+            */
+            void businessDaysChanged();
+            /*! Returns a number which changes whenever the business
+                days change.  Implementations whose business days
+                depend on other calendars must include the numbers
+                of the latter.
+            */
+            virtual unsigned long businessDaysGeneration() const;
+            //! returns the above number for the given calendar
+            static unsigned long businessDaysGeneration(const Calendar&);
+          private:
+            friend class Calendar;
+            friend class ScheduleCache;
+            /* Business days are cached as bitmaps covering the whole
+               range of allowed dates. The bitmaps are filled lazily
+               in blocks, each also storing its number of business
+               days; they are refilled when the business days of the
+               calendar change.  The cache is only created after the
+               calendar has been queried for a number of days, so
+               that short-lived calendars don't pay for it.
+
+               Blocks are refilled in place while other threads might
+               be reading them; as in a sequence lock, their contents
+               are atomic and readers check the generation of a block
+               again after reading it, retrying if it was changed. */
+            static const Date::serial_type firstCachedSerial = 367;    // Jan 1st, 1901
+            static const Date::serial_type lastCachedSerial = 109574;  // Dec 31st, 2199
+            static const Date::serial_type blockDays = 512;
+            static const Date::serial_type warmUpDays = 4*blockDays;
+            // generation of a block being filled
+            static const unsigned long fillingBlock = ~0UL;
+            struct CacheBlock {
+                std::atomic<unsigned long> generation;
+                std::atomic<std::uint64_t> days[blockDays/64];
+                std::atomic<Date::serial_type> businessDays;
+            };
+            typedef std::atomic<CacheBlock*> CacheSlot;
+            //! whether to use the cache for a query spanning the given days
+            bool useCache(Date::serial_type days) const;
+            bool isBusinessDayUncached(const Date&) const;
+            bool isBusinessDayCached(Date::serial_type offset) const;
+            //! business days in the closed range [from, to] of offsets
+            Date::serial_type businessDaysCached(Date::serial_type from,
+                                                 Date::serial_type to) const;
+            //! offset of the n-th business day after (before if n<0) the given one
+            /*! Returns a negative value if the result is not a cached date. */
+            Date::serial_type advanceCached(Date::serial_type offset,
+                                            Integer n) const;
+            //! reads a word of the i-th block and its business days
+            void cachedWord(Date::serial_type i,
+                            Date::serial_type word,
+                            std::uint64_t& days,
+                            Date::serial_type& businessDays) const;
+            void fillCacheBlock(Date::serial_type i) const;
+            std::atomic<unsigned long> businessDaysGeneration_{0};
+            mutable std::atomic<CacheSlot*> cache_{nullptr};
+            mutable std::atomic<Date::serial_type> uncachedDays_{0};
+            // owned by the mutex
+            mutable std::unique_ptr<CacheSlot[]> cacheSlots_;
+            mutable std::vector<std::unique_ptr<CacheBlock> > cacheBlocks_;
+            mutable std::mutex cacheMutex_;
         };
         ext::shared_ptr<Impl> impl_;
       public:
@@ -220,24 +291,52 @@ namespace QuantLib {
         return impl_->removedHolidays;
     }
 
-    inline bool Calendar::isBusinessDay(const Date& d) const {
-        QL_REQUIRE(impl_, "no calendar implementation provided");
+    inline void Calendar::Impl::cachedWord(Date::serial_type i,
+                                           Date::serial_type word,
+                                           std::uint64_t& days,
+                                           Date::serial_type& businessDays) const {
+        for (;;) {
+            const CacheSlot* slots = cache_.load(std::memory_order_acquire);
+            const CacheBlock* block = slots != nullptr ?
+                slots[i].load(std::memory_order_acquire) : nullptr;
+            if (block != nullptr) {
+                unsigned long generation =
+                    block->generation.load(std::memory_order_acquire);
+                if (generation == businessDaysGeneration()) {
+                    days = block->days[word].load(std::memory_order_relaxed);
+                    businessDays =
+                        block->businessDays.load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (block->generation.load(std::memory_order_relaxed)
+                            == generation)
+                        return;
+                }
+            }
+            fillCacheBlock(i);
+        }
+    }
 
-#ifdef QL_HIGH_RESOLUTION_DATE
-        const Date _d(d.dayOfMonth(), d.month(), d.year());
-#else
-        const Date& _d = d;
-#endif
+    inline bool Calendar::Impl::useCache(Date::serial_type days) const {
+        return cache_.load(std::memory_order_acquire) != nullptr
+            || uncachedDays_.fetch_add(days, std::memory_order_relaxed) >= warmUpDays;
+    }
 
-        if (!impl_->addedHolidays.empty() &&
-            impl_->addedHolidays.find(_d) != impl_->addedHolidays.end())
-            return false;
+    inline bool Calendar::Impl::isBusinessDayCached(Date::serial_type offset) const {
+        Date::serial_type k = offset % blockDays, businessDays;
+        std::uint64_t days;
+        cachedWord(offset / blockDays, k/64, days, businessDays);
+        return ((days >> (k%64)) & 1) != 0;
+    }
+
+    inline bool Calendar::isBusinessDay(const Date& d) const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
 
-        if (!impl_->removedHolidays.empty() &&
-            impl_->removedHolidays.find(_d) != impl_->removedHolidays.end())
-            return true;
+        Date::serial_type offset = d.serialNumber() - Impl::firstCachedSerial;
+        if (offset >= 0 && offset <= Impl::lastCachedSerial - Impl::firstCachedSerial
+            && impl_->useCache(1))
+            return impl_->isBusinessDayCached(offset);
 
-        return impl_->isBusinessDay(_d);
+        return impl_->isBusinessDayUncached(d);
     }
 
     inline bool Calendar::isEndOfMonth(const Date& d) const {
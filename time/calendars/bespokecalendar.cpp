@@ -39,6 +39,7 @@ namespace QuantLib {
 
     void BespokeCalendar::Impl::addWeekend(Weekday w) {
         weekend_.insert(w);
+        businessDaysChanged();
     }
 
 
@@ -120,6 +120,14 @@ namespace QuantLib {
         }
     }
 
+    unsigned long JointCalendar::Impl::businessDaysGeneration() const {
+        // increases whenever any of the calendars changes
+        unsigned long result = Calendar::Impl::businessDaysGeneration();
+        for (const auto& c : calendars_)
+            result += Calendar::Impl::businessDaysGeneration(c);
+        return result;
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
@@ -68,6 +68,9 @@ namespace QuantLib {
             bool isWeekend(Weekday) const override;
             bool isBusinessDay(const Date&) const override;
 
+          protected:
+            unsigned long businessDaysGeneration() const override;
+
           private:
             JointCalendarRule rule_;
             std::vector<Calendar> calendars_;
@@ -22,6 +22,7 @@
 #include <ql/settings.hpp>
 #include <ql/time/imm.hpp>
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -62,16 +63,16 @@ namespace QuantLib {
                        const boost::optional<bool>& endOfMonth,
                        std::vector<bool> isRegular)
     : tenor_(tenor), calendar_(std::move(calendar)), convention_(convention),
-      terminationDateConvention_(terminationDateConvention), rule_(rule), dates_(dates),
-      isRegular_(std::move(isRegular)) {
+      terminationDateConvention_(terminationDateConvention), rule_(rule),
+      data_(ext::make_shared<Data>(dates, std::move(isRegular))) {
 
         if (tenor != boost::none && !allowsEndOfMonth(*tenor))
             endOfMonth_ = false;
         else
             endOfMonth_ = endOfMonth;
 
-        QL_REQUIRE(isRegular_.empty() || isRegular_.size() == dates.size() - 1,
-                   "isRegular size (" << isRegular_.size()
+        QL_REQUIRE(data_->isRegular.empty() || data_->isRegular.size() == dates.size() - 1,
+                   "isRegular size (" << data_->isRegular.size()
                                       << ") must be zero or equal to the number of dates minus 1 ("
                                       << dates.size() - 1 << ")");
     }
@@ -86,6 +87,28 @@ namespace QuantLib {
                        bool endOfMonth,
                        const Date& first,
                        const Date& nextToLast)
+    : Schedule(
+          // a null effective date depends on the evaluation date
+          ScheduleCache::instance().enabled() && effectiveDate != Date() ?
+              ScheduleCache::instance().schedule(effectiveDate, terminationDate, tenor,
+                                                 cal, convention,
+                                                 terminationDateConvention, rule,
+                                                 endOfMonth, first, nextToLast) :
+              Schedule(Generate(), effectiveDate, terminationDate, tenor,
+                       std::move(cal), convention, terminationDateConvention,
+                       rule, endOfMonth, first, nextToLast)) {}
+
+    Schedule::Schedule(Generate,
+                       Date effectiveDate,
+                       const Date& terminationDate,
+                       const Period& tenor,
+                       Calendar cal,
+                       BusinessDayConvention convention,
+                       BusinessDayConvention terminationDateConvention,
+                       DateGeneration::Rule rule,
+                       bool endOfMonth,
+                       const Date& first,
+                       const Date& nextToLast)
     : tenor_(tenor), calendar_(std::move(cal)), convention_(convention),
       terminationDateConvention_(terminationDateConvention), rule_(rule),
       endOfMonth_(allowsEndOfMonth(tenor) ? endOfMonth : false),
@@ -182,6 +205,9 @@ namespace QuantLib {
         }
 
 
+        std::vector<Date> dates;
+        std::vector<bool> isRegular;
+
         // calendar needed for endOfMonth adjustment
         Calendar nullCalendar = NullCalendar();
         Integer periods = 1;
@@ -190,24 +216,24 @@ namespace QuantLib {
 
           case DateGeneration::Zero:
             tenor_ = 0*Years;
-            dates_.push_back(effectiveDate);
-            dates_.push_back(terminationDate);
-            isRegular_.push_back(true);
+            dates.push_back(effectiveDate);
+            dates.push_back(terminationDate);
+            isRegular.push_back(true);
             break;
 
           case DateGeneration::Backward:
 
-            dates_.push_back(terminationDate);
+            dates.push_back(terminationDate);
 
             seed = terminationDate;
             if (nextToLastDate_ != Date()) {
-                dates_.insert(dates_.begin(), nextToLastDate_);
+                dates.insert(dates.begin(), nextToLastDate_);
                 Date temp = nullCalendar.advance(seed,
                     -periods*(*tenor_), convention, *endOfMonth_);
                 if (temp!=nextToLastDate_)
-                    isRegular_.insert(isRegular_.begin(), false);
+                    isRegular.insert(isRegular.begin(), false);
                 else
-                    isRegular_.insert(isRegular_.begin(), true);
+                    isRegular.insert(isRegular.begin(), true);
                 seed = nextToLastDate_;
             }
 
@@ -220,28 +246,28 @@ namespace QuantLib {
                     -periods*(*tenor_), convention, *endOfMonth_);
                 if (temp < exitDate) {
                     if (firstDate_ != Date() &&
-                        (calendar_.adjust(dates_.front(),convention)!=
+                        (calendar_.adjust(dates.front(),convention)!=
                          calendar_.adjust(firstDate_,convention))) {
-                        dates_.insert(dates_.begin(), firstDate_);
-                        isRegular_.insert(isRegular_.begin(), false);
+                        dates.insert(dates.begin(), firstDate_);
+                        isRegular.insert(isRegular.begin(), false);
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.front(),convention)!=
+                    if (calendar_.adjust(dates.front(),convention)!=
                         calendar_.adjust(temp,convention)) {
-                        dates_.insert(dates_.begin(), temp);
-                        isRegular_.insert(isRegular_.begin(), true);
+                        dates.insert(dates.begin(), temp);
+                        isRegular.insert(isRegular.begin(), true);
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.front(),convention)!=
+            if (calendar_.adjust(dates.front(),convention)!=
                 calendar_.adjust(effectiveDate,convention)) {
-                dates_.insert(dates_.begin(), effectiveDate);
-                isRegular_.insert(isRegular_.begin(), false);
+                dates.insert(dates.begin(), effectiveDate);
+                isRegular.insert(isRegular.begin(), false);
             }
             break;
 
@@ -261,24 +287,24 @@ namespace QuantLib {
             if (*rule_ == DateGeneration::CDS || *rule_ == DateGeneration::CDS2015) {
                 Date prev20th = previousTwentieth(effectiveDate, *rule_);
                 if (calendar_.adjust(prev20th, convention) > effectiveDate) {
-                    dates_.push_back(prev20th - 3 * Months);
-                    isRegular_.push_back(true);
+                    dates.push_back(prev20th - 3 * Months);
+                    isRegular.push_back(true);
                 }
-                dates_.push_back(prev20th);
+                dates.push_back(prev20th);
             } else {
-                dates_.push_back(effectiveDate);
+                dates.push_back(effectiveDate);
             }
 
-            seed = dates_.back();
+            seed = dates.back();
 
             if (firstDate_!=Date()) {
-                dates_.push_back(firstDate_);
+                dates.push_back(firstDate_);
                 Date temp = nullCalendar.advance(seed, periods*(*tenor_),
                                                  convention, *endOfMonth_);
                 if (temp!=firstDate_)
-                    isRegular_.push_back(false);
+                    isRegular.push_back(false);
                 else
-                    isRegular_.push_back(true);
+                    isRegular.push_back(true);
                 seed = firstDate_;
             } else if (*rule_ == DateGeneration::Twentieth ||
                        *rule_ == DateGeneration::TwentiethIMM ||
@@ -295,8 +321,8 @@ namespace QuantLib {
                     }
                 }
                 if (next20th != effectiveDate) {
-                    dates_.push_back(next20th);
-                    isRegular_.push_back(*rule_ == DateGeneration::CDS || *rule_ == DateGeneration::CDS2015);
+                    dates.push_back(next20th);
+                    isRegular.push_back(*rule_ == DateGeneration::CDS || *rule_ == DateGeneration::CDS2015);
                     seed = next20th;
                 }
             }
@@ -309,36 +335,36 @@ namespace QuantLib {
                                                  convention, *endOfMonth_);
                 if (temp > exitDate) {
                     if (nextToLastDate_ != Date() &&
-                        (calendar_.adjust(dates_.back(),convention)!=
+                        (calendar_.adjust(dates.back(),convention)!=
                          calendar_.adjust(nextToLastDate_,convention))) {
-                        dates_.push_back(nextToLastDate_);
-                        isRegular_.push_back(false);
+                        dates.push_back(nextToLastDate_);
+                        isRegular.push_back(false);
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.back(),convention)!=
+                    if (calendar_.adjust(dates.back(),convention)!=
                         calendar_.adjust(temp,convention)) {
-                        dates_.push_back(temp);
-                        isRegular_.push_back(true);
+                        dates.push_back(temp);
+                        isRegular.push_back(true);
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.back(),terminationDateConvention)!=
+            if (calendar_.adjust(dates.back(),terminationDateConvention)!=
                 calendar_.adjust(terminationDate,terminationDateConvention)) {
                 if (*rule_ == DateGeneration::Twentieth ||
                     *rule_ == DateGeneration::TwentiethIMM ||
                     *rule_ == DateGeneration::OldCDS ||
                     *rule_ == DateGeneration::CDS ||
                     *rule_ == DateGeneration::CDS2015) {
-                    dates_.push_back(nextTwentieth(terminationDate, *rule_));
-                    isRegular_.push_back(true);
+                    dates.push_back(nextTwentieth(terminationDate, *rule_));
+                    isRegular.push_back(true);
                 } else {
-                    dates_.push_back(terminationDate);
-                    isRegular_.push_back(false);
+                    dates.push_back(terminationDate);
+                    isRegular.push_back(false);
                 }
             }
 
@@ -350,47 +376,47 @@ namespace QuantLib {
 
         // adjustments
         if (*rule_==DateGeneration::ThirdWednesday)
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = Date::nthWeekday(3, Wednesday,
-                                             dates_[i].month(),
-                                             dates_[i].year());
+            for (Size i=1; i<dates.size()-1; ++i)
+                dates[i] = Date::nthWeekday(3, Wednesday,
+                                             dates[i].month(),
+                                             dates[i].year());
         else if (*rule_ == DateGeneration::ThirdWednesdayInclusive)
-            for (auto& date : dates_)
+            for (auto& date : dates)
                 date = Date::nthWeekday(3, Wednesday, date.month(), date.year());
 
         if (*endOfMonth_ && calendar_.isEndOfMonth(seed)) {
             // adjust to end of month
             if (convention == Unadjusted) {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = Date::endOfMonth(dates_[i]);
+                for (Size i=1; i<dates.size()-1; ++i)
+                    dates[i] = Date::endOfMonth(dates[i]);
             } else {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = calendar_.endOfMonth(dates_[i]);
+                for (Size i=1; i<dates.size()-1; ++i)
+                    dates[i] = calendar_.endOfMonth(dates[i]);
             }
-            Date d1 = dates_.front(), d2 = dates_.back();
+            Date d1 = dates.front(), d2 = dates.back();
             if (terminationDateConvention != Unadjusted) {
-                d1 = calendar_.endOfMonth(dates_.front());
-                d2 = calendar_.endOfMonth(dates_.back());
+                d1 = calendar_.endOfMonth(dates.front());
+                d2 = calendar_.endOfMonth(dates.back());
             } else {
                 // the termination date is the first if going backwards,
                 // the last otherwise.
                 if (*rule_ == DateGeneration::Backward)
-                    d2 = Date::endOfMonth(dates_.back());
+                    d2 = Date::endOfMonth(dates.back());
                 else
-                    d1 = Date::endOfMonth(dates_.front());
+                    d1 = Date::endOfMonth(dates.front());
             }
             // if the eom adjustment leads to a single date schedule
             // we do not apply it
             if(d1 != d2) {
-                dates_.front() = d1;
-                dates_.back() = d2;
+                dates.front() = d1;
+                dates.back() = d2;
             }
         } else {
             // first date not adjusted for old CDS schedules
             if (*rule_ != DateGeneration::OldCDS)
-                dates_[0] = calendar_.adjust(dates_[0], convention);
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = calendar_.adjust(dates_[i], convention);
+                dates[0] = calendar_.adjust(dates[0], convention);
+            for (Size i=1; i<dates.size()-1; ++i)
+                dates[i] = calendar_.adjust(dates[i], convention);
 
             // termination date is NOT adjusted as per ISDA
             // specifications, unless otherwise specified in the
@@ -399,7 +425,7 @@ namespace QuantLib {
             if (terminationDateConvention != Unadjusted
                 && *rule_ != DateGeneration::CDS
                 && *rule_ != DateGeneration::CDS2015) {
-                dates_.back() = calendar_.adjust(dates_.back(),
+                dates.back() = calendar_.adjust(dates.back(),
                                                  terminationDateConvention);
             }
         }
@@ -408,26 +434,26 @@ namespace QuantLib {
         // necessary.  It can happen to be equal or later than the end
         // date due to EOM adjustments (see the Schedule test suite
         // for an example).
-        if (dates_.size() >= 2 && dates_[dates_.size()-2] >= dates_.back()) {
-            // there might be two dates only, then isRegular_ has size one
-            if (isRegular_.size() >= 2) {
-                isRegular_[isRegular_.size() - 2] =
-                    (dates_[dates_.size() - 2] == dates_.back());
+        if (dates.size() >= 2 && dates[dates.size()-2] >= dates.back()) {
+            // there might be two dates only, then isRegular has size one
+            if (isRegular.size() >= 2) {
+                isRegular[isRegular.size() - 2] =
+                    (dates[dates.size() - 2] == dates.back());
             }
-            dates_[dates_.size() - 2] = dates_.back();
-            dates_.pop_back();
-            isRegular_.pop_back();
+            dates[dates.size() - 2] = dates.back();
+            dates.pop_back();
+            isRegular.pop_back();
         }
-        if (dates_.size() >= 2 && dates_[1] <= dates_.front()) {
-            isRegular_[1] =
-                (dates_[1] == dates_.front());
-            dates_[1] = dates_.front();
-            dates_.erase(dates_.begin());
-            isRegular_.erase(isRegular_.begin());
+        if (dates.size() >= 2 && dates[1] <= dates.front()) {
+            isRegular[1] =
+                (dates[1] == dates.front());
+            dates[1] = dates.front();
+            dates.erase(dates.begin());
+            isRegular.erase(isRegular.begin());
         }
 
-        QL_ENSURE(dates_.size()>1,
-            "degenerate single date (" << dates_[0] << ") schedule" <<
+        QL_ENSURE(dates.size()>1,
+            "degenerate single date (" << dates[0] << ") schedule" <<
             "\n seed date: " << seed <<
             "\n exit date: " << exitDate <<
             "\n effective date: " << effectiveDate <<
@@ -436,27 +462,37 @@ namespace QuantLib {
             "\n termination date: " << terminationDate <<
             "\n generation rule: " << *rule_ <<
             "\n end of month: " << *endOfMonth_);
+
+        data_ = ext::make_shared<Data>(std::move(dates), std::move(isRegular));
+    }
+
+    const ext::shared_ptr<const Schedule::Data>& Schedule::noDates() {
+        static const ext::shared_ptr<const Data> empty =
+            ext::make_shared<Data>(std::vector<Date>(), std::vector<bool>());
+        return empty;
     }
 
     Schedule Schedule::after(const Date& truncationDate) const {
         Schedule result = *this;
+        std::vector<Date> dates = data_->dates;
+        std::vector<bool> isRegular = data_->isRegular;
 
-        QL_REQUIRE(truncationDate < result.dates_.back(),
+        QL_REQUIRE(truncationDate < dates.back(),
             "truncation date " << truncationDate <<
             " must be before the last schedule date " <<
-            result.dates_.back());
-        if (truncationDate > result.dates_[0]) {
+            dates.back());
+        if (truncationDate > dates[0]) {
             // remove earlier dates
-            while (result.dates_[0] < truncationDate) {
-                result.dates_.erase(result.dates_.begin());
-                if (!result.isRegular_.empty())
-                    result.isRegular_.erase(result.isRegular_.begin());
+            while (dates[0] < truncationDate) {
+                dates.erase(dates.begin());
+                if (!isRegular.empty())
+                    isRegular.erase(isRegular.begin());
             }
 
             // add truncationDate if missing
-            if (truncationDate != result.dates_.front()) {
-                result.dates_.insert(result.dates_.begin(), truncationDate);
-                result.isRegular_.insert(result.isRegular_.begin(), false);
+            if (truncationDate != dates.front()) {
+                dates.insert(dates.begin(), truncationDate);
+                isRegular.insert(isRegular.begin(), false);
                 result.terminationDateConvention_ = Unadjusted;
             }
             else {
@@ -467,6 +503,8 @@ namespace QuantLib {
                 result.nextToLastDate_ = Date();
             if (result.firstDate_ <= truncationDate)
                 result.firstDate_ = Date();
+
+            result.data_ = ext::make_shared<Data>(std::move(dates), std::move(isRegular));
         }
 
         return result;
@@ -474,23 +512,25 @@ namespace QuantLib {
 
     Schedule Schedule::until(const Date& truncationDate) const {
         Schedule result = *this;
+        std::vector<Date> dates = data_->dates;
+        std::vector<bool> isRegular = data_->isRegular;
 
-        QL_REQUIRE(truncationDate>result.dates_[0],
+        QL_REQUIRE(truncationDate>dates[0],
                    "truncation date " << truncationDate <<
                    " must be later than schedule first date " <<
-                   result.dates_[0]);
-        if (truncationDate<result.dates_.back()) {
+                   dates[0]);
+        if (truncationDate<dates.back()) {
             // remove later dates
-            while (result.dates_.back()>truncationDate) {
-                result.dates_.pop_back();
-                if(!result.isRegular_.empty())
-                    result.isRegular_.pop_back();
+            while (dates.back()>truncationDate) {
+                dates.pop_back();
+                if(!isRegular.empty())
+                    isRegular.pop_back();
             }
 
             // add truncationDate if missing
-            if (truncationDate!=result.dates_.back()) {
-                result.dates_.push_back(truncationDate);
-                result.isRegular_.push_back(false);
+            if (truncationDate!=dates.back()) {
+                dates.push_back(truncationDate);
+                isRegular.push_back(false);
                 result.terminationDateConvention_ = Unadjusted;
             } else {
                 result.terminationDateConvention_ = convention_;
@@ -500,6 +540,8 @@ namespace QuantLib {
                 result.nextToLastDate_ = Date();
             if (result.firstDate_>=truncationDate)
                 result.firstDate_ = Date();
+
+            result.data_ = ext::make_shared<Data>(std::move(dates), std::move(isRegular));
         }
 
         return result;
@@ -510,12 +552,12 @@ namespace QuantLib {
         Date d = (refDate==Date() ?
                   Settings::instance().evaluationDate() :
                   refDate);
-        return std::lower_bound(dates_.begin(), dates_.end(), d);
+        return std::lower_bound(data_->dates.begin(), data_->dates.end(), d);
     }
 
     Date Schedule::nextDate(const Date& refDate) const {
         auto res = lower_bound(refDate);
-        if (res!=dates_.end())
+        if (res!=data_->dates.end())
             return *res;
         else
             return {};
@@ -523,26 +565,26 @@ namespace QuantLib {
 
     Date Schedule::previousDate(const Date& refDate) const {
         auto res = lower_bound(refDate);
-        if (res!=dates_.begin())
+        if (res!=data_->dates.begin())
             return *(--res);
         else
             return {};
     }
 
-    bool Schedule::hasIsRegular() const { return !isRegular_.empty(); }
+    bool Schedule::hasIsRegular() const { return !data_->isRegular.empty(); }
 
     bool Schedule::isRegular(Size i) const {
         QL_REQUIRE(hasIsRegular(),
                    "full interface (isRegular) not available");
-        QL_REQUIRE(i<=isRegular_.size() && i>0,
+        QL_REQUIRE(i<=data_->isRegular.size() && i>0,
                    "index (" << i << ") must be in [1, " <<
-                   isRegular_.size() <<"]");
-        return isRegular_[i-1];
+                   data_->isRegular.size() <<"]");
+        return data_->isRegular[i-1];
     }
 
     const std::vector<bool>& Schedule::isRegular() const {
-        QL_REQUIRE(!isRegular_.empty(), "full interface (isRegular) not available");
-        return isRegular_;
+        QL_REQUIRE(!data_->isRegular.empty(), "full interface (isRegular) not available");
+        return data_->isRegular;
     }
 
     MakeSchedule& MakeSchedule::from(const Date& effectiveDate) {
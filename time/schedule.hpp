@@ -31,12 +31,20 @@
 #include <ql/time/period.hpp>
 #include <ql/time/dategenerationrule.hpp>
 #include <ql/errors.hpp>
+#include <ql/shared_ptr.hpp>
 #include <boost/optional.hpp>
+#include <utility>
 
 namespace QuantLib {
 
+    class ScheduleCache;
+
     //! Payment schedule
-    /*! \ingroup datetime */
+    /*! Copies of a schedule share the same immutable storage for
+        its dates.
+
+        \ingroup datetime
+    */
     class Schedule {
       public:
         /*! constructor that takes any list of dates, and optionally
@@ -66,20 +74,20 @@ namespace QuantLib {
         Schedule() = default;
         //! \name Date access
         //@{
-        Size size() const { return dates_.size(); }
+        Size size() const { return data_->dates.size(); }
         const Date& operator[](Size i) const;
         const Date& at(Size i) const;
         const Date& date(Size i) const;
         Date previousDate(const Date& refDate) const;
         Date nextDate(const Date& refDate) const;
-        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Date>& dates() const { return data_->dates; }
         bool hasIsRegular() const;
         bool isRegular(Size i) const;
         const std::vector<bool>& isRegular() const;
         //@}
         //! \name Other inspectors
         //@{
-        bool empty() const { return dates_.empty(); }
+        bool empty() const { return data_->dates.empty(); }
         const Calendar& calendar() const;
         const Date& startDate() const;
         const Date& endDate() const;
@@ -96,8 +104,8 @@ namespace QuantLib {
         //! \name Iterators
         //@{
         typedef std::vector<Date>::const_iterator const_iterator;
-        const_iterator begin() const { return dates_.begin(); }
-        const_iterator end() const { return dates_.end(); }
+        const_iterator begin() const { return data_->dates.begin(); }
+        const_iterator end() const { return data_->dates.end(); }
         const_iterator lower_bound(const Date& d = Date()) const;
         //@}
         //! \name Utilities
@@ -107,6 +115,27 @@ namespace QuantLib {
         Schedule until(const Date& truncationDate) const;
         //@}
       private:
+        friend class ScheduleCache;
+        struct Data {
+            Data(std::vector<Date> dates, std::vector<bool> isRegular)
+            : dates(std::move(dates)), isRegular(std::move(isRegular)) {}
+            std::vector<Date> dates;
+            std::vector<bool> isRegular;
+        };
+        struct Generate {};
+        //! rule based generation, bypassing the schedule cache
+        Schedule(Generate,
+                 Date effectiveDate,
+                 const Date& terminationDate,
+                 const Period& tenor,
+                 Calendar calendar,
+                 BusinessDayConvention convention,
+                 BusinessDayConvention terminationDateConvention,
+                 DateGeneration::Rule rule,
+                 bool endOfMonth,
+                 const Date& firstDate,
+                 const Date& nextToLastDate);
+        static const ext::shared_ptr<const Data>& noDates();
         boost::optional<Period> tenor_;
         Calendar calendar_;
         BusinessDayConvention convention_;
@@ -114,8 +143,7 @@ namespace QuantLib {
         boost::optional<DateGeneration::Rule> rule_;
         boost::optional<bool> endOfMonth_;
         Date firstDate_, nextToLastDate_;
-        std::vector<Date> dates_;
-        std::vector<bool> isRegular_;
+        ext::shared_ptr<const Data> data_ = noDates();
     };
 
 
@@ -158,19 +186,19 @@ namespace QuantLib {
     // inline definitions
 
     inline const Date& Schedule::date(Size i) const {
-        return dates_.at(i);
+        return data_->dates.at(i);
     }
 
     inline const Date& Schedule::operator[](Size i) const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
-        return dates_.at(i);
+        return data_->dates.at(i);
         #else
-        return dates_[i];
+        return data_->dates[i];
         #endif
     }
 
     inline const Date& Schedule::at(Size i) const {
-        return dates_.at(i);
+        return data_->dates.at(i);
     }
 
     inline const Calendar& Schedule::calendar() const {
@@ -178,10 +206,10 @@ namespace QuantLib {
     }
 
     inline const Date& Schedule::startDate() const {
-        return dates_.front();
+        return data_->dates.front();
     }
 
-    inline const Date &Schedule::endDate() const { return dates_.back(); }
+    inline const Date &Schedule::endDate() const { return data_->dates.back(); }
 
     inline bool Schedule::hasTenor() const {
         return tenor_ != boost::none;
@@ -0,0 +1,121 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/schedulecache.hpp>
+#include <boost/functional/hash.hpp>
+
+namespace QuantLib {
+
+    bool ScheduleCache::Key::operator==(const Key& o) const {
+        return effectiveDate == o.effectiveDate
+            && terminationDate == o.terminationDate
+            && tenorLength == o.tenorLength
+            && tenorUnits == o.tenorUnits
+            && calendar == o.calendar
+            && convention == o.convention
+            && terminationDateConvention == o.terminationDateConvention
+            && rule == o.rule
+            && endOfMonth == o.endOfMonth
+            && firstDate == o.firstDate
+            && nextToLastDate == o.nextToLastDate;
+    }
+
+    std::size_t ScheduleCache::KeyHasher::operator()(const Key& k) const {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, k.effectiveDate.serialNumber());
+        boost::hash_combine(seed, k.terminationDate.serialNumber());
+        boost::hash_combine(seed, k.tenorLength);
+        boost::hash_combine(seed, Integer(k.tenorUnits));
+        boost::hash_combine(seed, k.calendar);
+        boost::hash_combine(seed, Integer(k.convention));
+        boost::hash_combine(seed, Integer(k.terminationDateConvention));
+        boost::hash_combine(seed, Integer(k.rule));
+        boost::hash_combine(seed, k.endOfMonth);
+        boost::hash_combine(seed, k.firstDate.serialNumber());
+        boost::hash_combine(seed, k.nextToLastDate.serialNumber());
+        return seed;
+    }
+
+    void ScheduleCache::enable() {
+        enabled_.store(true, std::memory_order_relaxed);
+    }
+
+    void ScheduleCache::disable() {
+        enabled_.store(false, std::memory_order_relaxed);
+        clear();
+    }
+
+    Size ScheduleCache::size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return schedules_.size();
+    }
+
+    void ScheduleCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        schedules_.clear();
+    }
+
+    Schedule ScheduleCache::schedule(const Date& effectiveDate,
+                                     const Date& terminationDate,
+                                     const Period& tenor,
+                                     const Calendar& calendar,
+                                     BusinessDayConvention convention,
+                                     BusinessDayConvention terminationDateConvention,
+                                     DateGeneration::Rule rule,
+                                     bool endOfMonth,
+                                     const Date& firstDate,
+                                     const Date& nextToLastDate) {
+        if (calendar.empty())
+            return Schedule(Schedule::Generate(), effectiveDate, terminationDate,
+                            tenor, calendar, convention, terminationDateConvention,
+                            rule, endOfMonth, firstDate, nextToLastDate);
+
+        Key key = {effectiveDate, terminationDate,
+                   tenor.length(), tenor.units(),
+                   calendar.impl_.get(),
+                   convention, terminationDateConvention,
+                   rule, endOfMonth,
+                   firstDate, nextToLastDate};
+        const Calendar::Impl& impl = *calendar.impl_;
+        unsigned long generation = impl.businessDaysGeneration();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto i = schedules_.find(key);
+            // if the holidays changed, the schedule is generated again
+            if (i != schedules_.end() && i->second.first == generation)
+                return i->second.second;
+        }
+
+        // generated outside the lock; if another thread generated
+        // the same schedule in the meantime, the first one is kept.
+        Schedule result(Schedule::Generate(), effectiveDate, terminationDate,
+                        tenor, calendar, convention, terminationDateConvention,
+                        rule, endOfMonth, firstDate, nextToLastDate);
+        std::lock_guard<std::mutex> lock(mutex_);
+        // holidays might have changed while generating the schedule
+        if (impl.businessDaysGeneration() != generation)
+            return result;
+        auto i = schedules_.find(key);
+        if (i == schedules_.end())
+            i = schedules_.emplace(std::move(key),
+                                   std::make_pair(generation, std::move(result))).first;
+        else if (i->second.first != generation)
+            i->second = std::make_pair(generation, std::move(result));
+        return i->second.second;
+    }
+
+}
@@ -0,0 +1,110 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file schedulecache.hpp
+    \brief opt-in cache of generated schedules
+*/
+
+#ifndef quantlib_schedule_cache_hpp
+#define quantlib_schedule_cache_hpp
+
+#include <ql/patterns/singleton.hpp>
+#include <ql/time/schedule.hpp>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace QuantLib {
+
+    //! cache of rule-based schedules
+    /*! When enabled, schedules built by the rule-based Schedule
+        constructor (and therefore by MakeSchedule) are interned:
+        schedules with the same generation parameters are generated
+        once and then share the same immutable storage for their
+        dates.  This reduces both the time and the memory needed to
+        load large portfolios of vanilla instruments.
+
+        Calendars are identified by their implementation rather than
+        by their name, since different calendars (e.g., bespoke or
+        joint calendars) can have the same name.  Schedules are
+        generated again when the holidays of their calendar change.
+
+        The cache is disabled by default.
+
+        \ingroup datetime
+    */
+    class ScheduleCache : public Singleton<ScheduleCache> {
+        friend class Singleton<ScheduleCache>;
+      private:
+        ScheduleCache() = default;
+      public:
+        //! \name Settings
+        //@{
+        bool enabled() const;
+        void enable();
+        //! disables the cache; cached schedules are released
+        void disable();
+        //@}
+        //! \name Cache management
+        //@{
+        Size size() const;
+        void clear();
+        //@}
+        //! returns the cached schedule, generating it if needed
+        Schedule schedule(const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate = Date(),
+                          const Date& nextToLastDate = Date());
+      private:
+        struct Key {
+            Date effectiveDate, terminationDate;
+            Integer tenorLength;
+            TimeUnit tenorUnits;
+            // the implementation is kept alive by the cached schedule
+            const Calendar::Impl* calendar;
+            BusinessDayConvention convention, terminationDateConvention;
+            DateGeneration::Rule rule;
+            bool endOfMonth;
+            Date firstDate, nextToLastDate;
+            bool operator==(const Key&) const;
+        };
+        struct KeyHasher {
+            std::size_t operator()(const Key&) const;
+        };
+        std::atomic<bool> enabled_{false};
+        mutable std::mutex mutex_;
+        // schedules with the business days generation of their calendar
+        std::unordered_map<Key, std::pair<unsigned long, Schedule>,
+                           KeyHasher> schedules_;
+    };
+
+    // inline definitions
+
+    inline bool ScheduleCache::enabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+}
+
+#endif
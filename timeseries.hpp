@@ -29,6 +29,7 @@
 #include <ql/utilities/null.hpp>
 #include <ql/errors.hpp>
 #include <ql/functional.hpp>
+#include <boost/container/flat_map.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/iterator/reverse_iterator.hpp>
 #include <boost/utility.hpp>
@@ -47,6 +48,12 @@ namespace QuantLib {
 
         \pre The <c>Container</c> type must satisfy the requirements
              set by the C++ standard for associative containers.
+
+        \note The default container is node-based.  For long series
+              which are mostly built in date order and then scanned,
+              FlatTimeSeries (using a sorted vector) gives better
+              memory locality; appending data after the last date
+              takes amortized constant time with either container.
     */
     template <class T, class Container = std::map<Date, T> >
     class TimeSeries {
@@ -95,16 +102,18 @@ namespace QuantLib {
         //@{
         //! returns the (possibly null) datum corresponding to the given date
         T operator[](const Date& d) const {
-            if (values_.find(d) != values_.end())
-                return values_[d];
+            auto i = values_.find(d);
+            if (i != values_.end())
+                return i->second;
             else
                 return Null<T>();
         }
         T& operator[](const Date& d) {
-            if (values_.find(d) == values_.end())
-                values_[d] = Null<T>();
-            return values_[d];
+            return insert(d, enable_reverse());
         }
+        //! returns the last non-null datum at or before the given date
+        /*! A null value is returned if no such datum exists. */
+        T asOf(const Date& d) const;
         //@}
 
         //! \name Iterators
@@ -172,11 +181,28 @@ namespace QuantLib {
         //@}
 
       private:
+        // data are usually added in date order; containers sorted by
+        // date can append them at the end without a search
+        T& insert(const Date& d, std::bidirectional_iterator_tag) {
+            if (values_.empty() || values_.rbegin()->first < d)
+                return values_.emplace_hint(values_.end(), d, Null<T>())->second;
+            return values_.emplace(d, Null<T>()).first->second;
+        }
+        T& insert(const Date& d, std::input_iterator_tag) {
+            return values_.emplace(d, Null<T>()).first->second;
+        }
+
         typedef typename Container::value_type container_value_type;
-        typedef ext::function<Date(const container_value_type&)>
-                                                              projection_time;
-        typedef ext::function<T(const container_value_type&)>
-                                                             projection_value;
+        struct projection_time {
+            const Date& operator()(const container_value_type& v) const {
+                return v.first;
+            }
+        };
+        struct projection_value {
+            const T& operator()(const container_value_type& v) const {
+                return v.second;
+            }
+        };
 
       public:
         //! \name Projection iterators
@@ -194,49 +220,48 @@ namespace QuantLib {
                                                  const_reverse_value_iterator;
 
         const_value_iterator cbegin_values() const {
-            return const_value_iterator(cbegin(), get_value);
+            return const_value_iterator(cbegin(), projection_value());
         }
         const_value_iterator cend_values() const {
-            return const_value_iterator(cend(), get_value);
+            return const_value_iterator(cend(), projection_value());
         }
         const_reverse_value_iterator crbegin_values() const {
-            return const_reverse_value_iterator(crbegin(), get_value);
+            return const_reverse_value_iterator(crbegin(), projection_value());
         }
         const_reverse_value_iterator crend_values() const {
-            return const_reverse_value_iterator(crend(), get_value);
+            return const_reverse_value_iterator(crend(), projection_value());
         }
 
         const_time_iterator cbegin_time() const {
-            return const_time_iterator(cbegin(), get_time);
+            return const_time_iterator(cbegin(), projection_time());
         }
         const_time_iterator cend_time() const {
-            return const_time_iterator(cend(), get_time);
+            return const_time_iterator(cend(), projection_time());
         }
         const_reverse_time_iterator crbegin_time() const {
-            return const_reverse_time_iterator(crbegin(), get_time);
+            return const_reverse_time_iterator(crbegin(), projection_time());
         }
         const_reverse_time_iterator crend_time() const {
-            return const_reverse_time_iterator(crend(), get_time);
+            return const_reverse_time_iterator(crend(), projection_time());
         }
 
         //! \name Utilities
         //@{
         const_iterator find(const Date&);
+        //! returns the range of data between the given dates, both included
+        std::pair<const_iterator, const_iterator>
+        window(const Date& start, const Date& end) const;
         //! returns the dates for which historical data exist
         std::vector<Date> dates() const;
         //! returns the historical data
         std::vector<T> values() const;
         //@}
-
-      private:
-        static const Date& get_time (const container_value_type& v) {
-            return v.first;
-        }
-        static const T& get_value (const container_value_type& v) {
-            return v.second;
-        }
     };
 
+    //! time series backed by a sorted vector
+    template <class T>
+    using FlatTimeSeries = TimeSeries<T, boost::container::flat_map<Date, T> >;
+
 
     // inline definitions
 
@@ -285,12 +310,32 @@ namespace QuantLib {
         return i;
     }
 
+    template <class T, class C>
+    T TimeSeries<T,C>::asOf(const Date& d) const {
+        auto i = values_.upper_bound(d);
+        while (i != values_.begin()) {
+            --i;
+            if (i->second != Null<T>())
+                return i->second;
+        }
+        return Null<T>();
+    }
+
+    template <class T, class C>
+    std::pair<typename TimeSeries<T,C>::const_iterator,
+              typename TimeSeries<T,C>::const_iterator>
+    TimeSeries<T,C>::window(const Date& start, const Date& end) const {
+        const_iterator first = values_.lower_bound(start);
+        const_iterator last = start <= end ? values_.upper_bound(end) : first;
+        return { first, last };
+    }
+
     template <class T, class C>
     std::vector<Date> TimeSeries<T,C>::dates() const {
         std::vector<Date> v;
         v.reserve(size());
         std::transform(cbegin(), cend(), std::back_inserter(v),
-                       TimeSeries<T,C>::get_time);
+                       projection_time());
         return v;
     }
 
@@ -299,7 +344,7 @@ namespace QuantLib {
         std::vector<T> v;
         v.reserve(size());
         std::transform(cbegin(), cend(), std::back_inserter(v),
-                       TimeSeries<T,C>::get_value);
+                       projection_value());
         return v;
     }
 